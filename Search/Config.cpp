@@ -3,6 +3,21 @@
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/ini_parser.hpp>
 
+#include <sstream>
+
+static std::vector<std::string> splitList(const std::string& value)
+{
+    std::vector<std::string> items;
+    std::istringstream iss(value);
+    std::string item;
+    while (std::getline(iss, item, ',')) {
+        auto b = item.find_first_not_of(" \t");
+        auto e = item.find_last_not_of(" \t");
+        if (b != std::string::npos) items.push_back(item.substr(b, e - b + 1));
+    }
+    return items;
+}
+
 Config::Config(const std::string& filename)
 {
     boost::property_tree::ptree pt;
@@ -13,11 +28,45 @@ Config::Config(const std::string& filename)
     m_dbName = pt.get<std::string>("DataBase.bd_name");
     m_dbUser = pt.get<std::string>("DataBase.bd_user");
     m_dbPass = pt.get<std::string>("DataBase.bd_pass");
+    m_dbShards = splitList(pt.get<std::string>("DataBase.bd_shards", ""));
 
     m_startPage = pt.get<std::string>("Client.start_page");
     m_recursionDepth = pt.get<int>("Client.recursion_depth");
+    m_maxPageBytes = pt.get<int>("Client.max_page_bytes", 4 * 1024 * 1024);
+    m_fetchChunkBytes = pt.get<int>("Client.fetch_chunk_bytes", 16 * 1024);
+    m_nearDuplicateDistance = pt.get<int>("Client.near_duplicate_distance", 3);
+    m_dnsTtlSec = pt.get<int>("Client.dns_ttl_sec", 300);
+    m_dnsNegativeTtlSec = pt.get<int>("Client.dns_negative_ttl_sec", 30);
+    m_dnsThreads = pt.get<int>("Client.dns_threads", 4);
+    m_spiderPeers = splitList(pt.get<std::string>("Client.spider_peers", ""));
+    m_spiderId = pt.get<int>("Client.spider_id", 0);
+    m_forwardBatchSize = pt.get<int>("Client.forward_batch_size", 64);
+    m_forwardFlushMs = pt.get<int>("Client.forward_flush_ms", 200);
+    m_terminationProbeMs = pt.get<int>("Client.termination_probe_ms", 500);
 
     m_serverPort = pt.get<int>("Server.server_port");
+
+    m_maxConnections = pt.get<int>("Server.max_connections", 256);
+    m_maxActiveQueries = pt.get<int>("Server.max_active_queries", 4);
+    m_maxQueuedQueries = pt.get<int>("Server.max_queued_queries", 16);
+    m_queueTimeoutMs = pt.get<int>("Server.queue_timeout_ms", 200);
+    m_requestTimeoutMs = pt.get<int>("Server.request_timeout_ms", 2000);
+    m_readTimeoutMs = pt.get<int>("Server.read_timeout_ms", 5000);
+    m_maxHeaderBytes = pt.get<int>("Server.max_header_bytes", 8192);
+    m_maxBodyBytes = pt.get<int>("Server.max_body_bytes", 4096);
+    m_retryAfterSec = pt.get<int>("Server.retry_after_sec", 1);
+    m_suggestRefreshSec = pt.get<int>("Server.suggest_refresh_sec", 300);
+    m_suggestLimit = pt.get<int>("Server.suggest_limit", 10);
+    m_phraseCandidates = pt.get<int>("Server.phrase_candidates", 200);
+
+    m_serverMode = pt.get<std::string>("Server.mode", "single");
+    m_shardServers = splitList(pt.get<std::string>("Server.shard_servers", ""));
+    m_shardTimeoutMs = pt.get<int>("Server.shard_timeout_ms", 1000);
+
+    m_stemLanguages = splitList(pt.get<std::string>("Analyzer.stem_languages", "en,ru"));
+    m_stopWordLanguages = splitList(pt.get<std::string>("Analyzer.stop_words", "en,ru"));
+    m_stopWordsFile = pt.get<std::string>("Analyzer.stop_words_file", "");
+    m_reindexWaitSec = pt.get<int>("Analyzer.reindex_wait_sec", 3600);
 }
 
 std::string Config::GetDbHost() const { return m_dbHost; }
@@ -25,7 +74,41 @@ int Config::GetDbPort() const { return m_dbPort; }
 std::string Config::GetDbName() const { return m_dbName; }
 std::string Config::GetDbUser() const { return m_dbUser; }
 std::string Config::GetDbPass() const { return m_dbPass; }
+std::vector<std::string> Config::GetDbShards() const { return m_dbShards; }
 
 std::string Config::GetStartPage() const { return m_startPage; }
 int Config::GetRecursionDepth() const { return m_recursionDepth; }
+int Config::GetMaxPageBytes() const { return m_maxPageBytes; }
+int Config::GetFetchChunkBytes() const { return m_fetchChunkBytes; }
+int Config::GetNearDuplicateDistance() const { return m_nearDuplicateDistance; }
+int Config::GetDnsTtlSec() const { return m_dnsTtlSec; }
+int Config::GetDnsNegativeTtlSec() const { return m_dnsNegativeTtlSec; }
+int Config::GetDnsThreads() const { return m_dnsThreads; }
+std::vector<std::string> Config::GetSpiderPeers() const { return m_spiderPeers; }
+int Config::GetSpiderId() const { return m_spiderId; }
+int Config::GetForwardBatchSize() const { return m_forwardBatchSize; }
+int Config::GetForwardFlushMs() const { return m_forwardFlushMs; }
+int Config::GetTerminationProbeMs() const { return m_terminationProbeMs; }
 int Config::GetServerPort() const { return m_serverPort; }
+
+int Config::GetMaxConnections() const { return m_maxConnections; }
+int Config::GetMaxActiveQueries() const { return m_maxActiveQueries; }
+int Config::GetMaxQueuedQueries() const { return m_maxQueuedQueries; }
+int Config::GetQueueTimeoutMs() const { return m_queueTimeoutMs; }
+int Config::GetRequestTimeoutMs() const { return m_requestTimeoutMs; }
+int Config::GetReadTimeoutMs() const { return m_readTimeoutMs; }
+int Config::GetMaxHeaderBytes() const { return m_maxHeaderBytes; }
+int Config::GetMaxBodyBytes() const { return m_maxBodyBytes; }
+int Config::GetRetryAfterSec() const { return m_retryAfterSec; }
+int Config::GetSuggestRefreshSec() const { return m_suggestRefreshSec; }
+int Config::GetSuggestLimit() const { return m_suggestLimit; }
+int Config::GetPhraseCandidates() const { return m_phraseCandidates; }
+
+std::string Config::GetServerMode() const { return m_serverMode; }
+std::vector<std::string> Config::GetShardServers() const { return m_shardServers; }
+int Config::GetShardTimeoutMs() const { return m_shardTimeoutMs; }
+
+std::vector<std::string> Config::GetStemLanguages() const { return m_stemLanguages; }
+std::vector<std::string> Config::GetStopWordLanguages() const { return m_stopWordLanguages; }
+std::string Config::GetStopWordsFile() const { return m_stopWordsFile; }
+int Config::GetReindexWaitSec() const { return m_reindexWaitSec; }
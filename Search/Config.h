@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include <vector>
 
 class Config 
 {
@@ -11,19 +12,97 @@ public:
     std::string GetDbName() const;
     std::string GetDbUser() const;
     std::string GetDbPass() const;
+    //  - (bd_shards);  -   bd_name
+    std::vector<std::string> GetDbShards() const;
 
     std::string GetStartPage() const;
     int GetRecursionDepth() const;
+    int GetMaxPageBytes() const;
+    int GetFetchChunkBytes() const;
+    // -:         (0..3), -1 -  
+    int GetNearDuplicateDistance() const;
+    int GetDnsTtlSec() const;
+    int GetDnsNegativeTtlSec() const;
+    int GetDnsThreads() const;
+    //  : "host:port"      ;
+    //  -     
+    std::vector<std::string> GetSpiderPeers() const;
+    int GetSpiderId() const;
+    int GetForwardBatchSize() const;
+    int GetForwardFlushMs() const;
+    //    0 ,     
+    int GetTerminationProbeMs() const;
     int GetServerPort() const;
 
+    int GetMaxConnections() const;
+    int GetMaxActiveQueries() const;
+    int GetMaxQueuedQueries() const;
+    int GetQueueTimeoutMs() const;
+    int GetRequestTimeoutMs() const;
+    int GetReadTimeoutMs() const;
+    int GetMaxHeaderBytes() const;
+    int GetMaxBodyBytes() const;
+    int GetRetryAfterSec() const;
+    int GetSuggestRefreshSec() const;
+    int GetSuggestLimit() const;
+    //    :       ;
+    //   :  ,    
+    int GetPhraseCandidates() const;
+
+    // "single" -  /, "coordinator" -   shard_servers
+    std::string GetServerMode() const;
+    std::vector<std::string> GetShardServers() const;
+    int GetShardTimeoutMs() const;
+
+    //  ,     : "en", "ru"
+    std::vector<std::string> GetStemLanguages() const;
+    std::vector<std::string> GetStopWordLanguages() const;
+    std::string GetStopWordsFile() const;
+    //   ,   0     
+    int GetReindexWaitSec() const;
+
 private:
     std::string m_dbHost;
     int m_dbPort;
     std::string m_dbName;
     std::string m_dbUser;
     std::string m_dbPass;
+    std::vector<std::string> m_dbShards;
 
     std::string m_startPage;
     int m_recursionDepth;
+    int m_maxPageBytes;
+    int m_fetchChunkBytes;
+    int m_nearDuplicateDistance;
+    int m_dnsTtlSec;
+    int m_dnsNegativeTtlSec;
+    int m_dnsThreads;
+    std::vector<std::string> m_spiderPeers;
+    int m_spiderId;
+    int m_forwardBatchSize;
+    int m_forwardFlushMs;
+    int m_terminationProbeMs;
     int m_serverPort;
+
+    int m_maxConnections;
+    int m_maxActiveQueries;
+    int m_maxQueuedQueries;
+    int m_queueTimeoutMs;
+    int m_requestTimeoutMs;
+    int m_readTimeoutMs;
+    int m_maxHeaderBytes;
+    int m_maxBodyBytes;
+    int m_retryAfterSec;
+    int m_suggestRefreshSec;
+    int m_suggestLimit;
+    int m_phraseCandidates;
+
+    std::string m_serverMode;
+    std::vector<std::string> m_shardServers;
+    int m_shardTimeoutMs;
+
+    std::vector<std::string> m_stemLanguages;
+    std::vector<std::string> m_stopWordLanguages;
+    std::string m_stopWordsFile;
+    int m_reindexWaitSec;
 };
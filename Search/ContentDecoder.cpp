@@ -0,0 +1,168 @@
+#include "ContentDecoder.h"
+
+#include <zlib.h>
+#ifdef SEARCH_WITH_BROTLI
+#include <brotli/decode.h>
+#endif
+
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+
+namespace {
+
+const std::size_t kOutputChunk = 16 * 1024;
+
+} // namespace
+
+struct ContentDecoder::Impl
+{
+    z_stream zs{};
+    bool zlibReady = false;
+    bool finished = false;
+    //   deflate,   ,   zlib-
+    std::string head;
+#ifdef SEARCH_WITH_BROTLI
+    BrotliDecoderState* brotli = nullptr;
+#endif
+    char buffer[kOutputChunk];
+};
+
+const char* ContentDecoder::acceptEncoding()
+{
+#ifdef SEARCH_WITH_BROTLI
+    return "gzip, deflate, br";
+#else
+    return "gzip, deflate";
+#endif
+}
+
+bool ContentDecoder::parseEncoding(const std::string& value, Encoding& encoding)
+{
+    std::string v;
+    for (unsigned char c : value) {
+        if (!std::isspace(c)) v.push_back(static_cast<char>(std::tolower(c)));
+    }
+
+    if (v.empty() || v == "identity") encoding = Encoding::Identity;
+    else if (v == "gzip" || v == "x-gzip") encoding = Encoding::Gzip;
+    else if (v == "deflate") encoding = Encoding::Deflate;
+#ifdef SEARCH_WITH_BROTLI
+    else if (v == "br") encoding = Encoding::Brotli;
+#endif
+    else return false;
+    return true;
+}
+
+ContentDecoder::ContentDecoder(Encoding encoding, HtmlTokenizer& out, std::uint64_t maxOutput)
+    : m_encoding(encoding), m_out(out), m_maxOutput(maxOutput), m_impl(std::make_unique<Impl>())
+{
+#ifdef SEARCH_WITH_BROTLI
+    if (m_encoding == Encoding::Brotli) {
+        m_impl->brotli = BrotliDecoderCreateInstance(nullptr, nullptr, nullptr);
+        if (!m_impl->brotli) throw std::runtime_error("BrotliDecoderCreateInstance failed");
+    }
+#endif
+}
+
+ContentDecoder::~ContentDecoder()
+{
+    if (m_impl->zlibReady) inflateEnd(&m_impl->zs);
+#ifdef SEARCH_WITH_BROTLI
+    if (m_impl->brotli) BrotliDecoderDestroyInstance(m_impl->brotli);
+#endif
+}
+
+bool ContentDecoder::feed(const char* data, std::size_t size)
+{
+    m_inputBytes += size;
+    switch (m_encoding) {
+    case Encoding::Gzip:
+    case Encoding::Deflate:
+        return inflateChunk(data, size);
+    case Encoding::Brotli:
+        return brotliChunk(data, size);
+    default:
+        return emit(data, size);
+    }
+}
+
+bool ContentDecoder::emit(const char* data, std::size_t size)
+{
+    std::uint64_t room = m_maxOutput - m_outputBytes;
+    std::size_t take = static_cast<std::size_t>(std::min<std::uint64_t>(size, room));
+    m_out.feed(data, take);
+    m_outputBytes += take;
+    return take == size;
+}
+
+bool ContentDecoder::inflateChunk(const char* data, std::size_t size)
+{
+    Impl& im = *m_impl;
+    if (im.finished) return true;
+
+    if (!im.zlibReady) {
+        int windowBits = 15 + 32; // gzip  zlib -  
+        if (m_encoding == Encoding::Deflate) {
+            // "deflate"  RFC - zlib-,      deflate
+            im.head.append(data, size);
+            if (im.head.size() < 2) return true;
+            unsigned b0 = static_cast<unsigned char>(im.head[0]);
+            unsigned b1 = static_cast<unsigned char>(im.head[1]);
+            bool zlibHeader = (b0 & 0x0F) == 8 && ((b0 << 8) | b1) % 31 == 0;
+            windowBits = zlibHeader ? 15 : -15;
+        }
+        if (inflateInit2(&im.zs, windowBits) != Z_OK) throw std::runtime_error("inflateInit2 failed");
+        im.zlibReady = true;
+
+        if (!im.head.empty()) {
+            std::string head;
+            head.swap(im.head);
+            m_inputBytes -= head.size();
+            return feed(head.data(), head.size());
+        }
+    }
+
+    im.zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+    im.zs.avail_in = static_cast<uInt>(size);
+    do {
+        im.zs.next_out = reinterpret_cast<Bytef*>(im.buffer);
+        im.zs.avail_out = static_cast<uInt>(sizeof(im.buffer));
+
+        int rc = inflate(&im.zs, Z_NO_FLUSH);
+        if (rc == Z_STREAM_END) im.finished = true;
+        else if (rc == Z_BUF_ERROR) break;
+        else if (rc != Z_OK) throw std::runtime_error(std::string("inflate failed: ") + (im.zs.msg ? im.zs.msg : "corrupt data"));
+
+        if (!emit(im.buffer, sizeof(im.buffer) - im.zs.avail_out)) return false;
+    } while (!im.finished && (im.zs.avail_in > 0 || im.zs.avail_out == 0));
+    return true;
+}
+
+bool ContentDecoder::brotliChunk(const char* data, std::size_t size)
+{
+#ifdef SEARCH_WITH_BROTLI
+    Impl& im = *m_impl;
+    if (im.finished) return true;
+
+    const std::uint8_t* next = reinterpret_cast<const std::uint8_t*>(data);
+    std::size_t avail = size;
+    for (;;) {
+        std::uint8_t* out = reinterpret_cast<std::uint8_t*>(im.buffer);
+        std::size_t room = sizeof(im.buffer);
+
+        auto rc = BrotliDecoderDecompressStream(im.brotli, &avail, &next, &room, &out, nullptr);
+        if (rc == BROTLI_DECODER_RESULT_ERROR) {
+            throw std::runtime_error(std::string("brotli failed: ") +
+                BrotliDecoderErrorString(BrotliDecoderGetErrorCode(im.brotli)));
+        }
+        if (!emit(im.buffer, sizeof(im.buffer) - room)) return false;
+        if (rc == BROTLI_DECODER_RESULT_SUCCESS) im.finished = true;
+        if (rc != BROTLI_DECODER_RESULT_NEEDS_MORE_OUTPUT) return true;
+    }
+#else
+    (void)data;
+    (void)size;
+    throw std::runtime_error("brotli support is not compiled in");
+#endif
+}
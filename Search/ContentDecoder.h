@@ -0,0 +1,50 @@
+#pragma once
+#ifndef CONTENT_DECODER_H
+#define CONTENT_DECODER_H
+
+#include "HtmlTokenizer.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+//     (Content-Encoding)    HtmlTokenizer.
+// gzip/deflate -  zlib, br -    SEARCH_WITH_BROTLI.
+class ContentDecoder
+{
+public:
+    enum class Encoding { Identity, Gzip, Deflate, Brotli };
+
+    //  Accept-Encoding   
+    static const char* acceptEncoding();
+    // false -   
+    static bool parseEncoding(const std::string& value, Encoding& encoding);
+
+    // maxOutput -    (  zip-)
+    ContentDecoder(Encoding encoding, HtmlTokenizer& out, std::uint64_t maxOutput);
+    ~ContentDecoder();
+
+    // false -  maxOutput ,     .
+    //   - std::runtime_error
+    bool feed(const char* data, std::size_t size);
+
+    std::uint64_t inputBytes() const { return m_inputBytes; }
+    std::uint64_t outputBytes() const { return m_outputBytes; }
+
+private:
+    struct Impl;
+
+    bool emit(const char* data, std::size_t size);
+    bool inflateChunk(const char* data, std::size_t size);
+    bool brotliChunk(const char* data, std::size_t size);
+
+    Encoding m_encoding;
+    HtmlTokenizer& m_out;
+    std::uint64_t m_maxOutput;
+    std::uint64_t m_inputBytes = 0;
+    std::uint64_t m_outputBytes = 0;
+    std::unique_ptr<Impl> m_impl;
+};
+
+#endif // CONTENT_DECODER_H
@@ -0,0 +1,484 @@
+#include "CrawlExchange.h"
+#include "Hash.h"
+
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+namespace beast = boost::beast;
+namespace net = boost::asio;
+using tcp = net::ip::tcp;
+
+namespace {
+
+const int kSendTimeoutMs = 2000;
+//  ,    ,       
+const int kFailureReportEvery = 50;
+const int kTerminateAttempts = 10;
+const std::size_t kMaxLineBytes = 8192;
+const std::size_t kMaxForwarded = 1 << 20;
+
+// count       
+bool parseNumbers(const std::string& text, std::size_t count, std::vector<std::uint64_t>& out)
+{
+    std::istringstream iss(text);
+    out.assign(count, 0);
+    for (auto& v : out) {
+        if (!(iss >> v)) return false;
+    }
+    std::string rest;
+    return !(iss >> rest);
+}
+
+std::uint64_t newEpoch()
+{
+    std::random_device rd;
+    std::uint64_t epoch = (static_cast<std::uint64_t>(rd()) << 32) ^ rd()
+        ^ static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    return epoch ? epoch : 1;
+}
+
+std::string takeLine(net::streambuf& buf, std::size_t n)
+{
+    auto begin = net::buffers_begin(buf.data());
+    std::string line(begin, begin + static_cast<std::ptrdiff_t>(n - 1));
+    buf.consume(n);
+    return line;
+}
+
+} // namespace
+
+std::string urlHost(const std::string& url)
+{
+    auto scheme = url.find("://");
+    if (scheme == std::string::npos) return {};
+    auto start = scheme + 3;
+    auto end = url.find_first_of("/?#", start);
+    std::string host = url.substr(start, end == std::string::npos ? std::string::npos : end - start);
+
+    auto at = host.rfind('@');
+    if (at != std::string::npos) host.erase(0, at + 1);
+    std::transform(host.begin(), host.end(), host.begin(),
+        [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return host;
+}
+
+bool splitHostPort(const std::string& authority, unsigned short defaultPort, std::string& host, unsigned short& port)
+{
+    // IPv6-  : [::1]:8080
+    std::size_t hostEnd = authority.size();
+    std::size_t colon = std::string::npos;
+    if (!authority.empty() && authority[0] == '[') {
+        auto close = authority.find(']');
+        if (close == std::string::npos) return false;
+        host = authority.substr(1, close - 1);
+        if (close + 1 < authority.size()) {
+            if (authority[close + 1] != ':') return false;
+            colon = close + 1;
+        }
+    }
+    else {
+        colon = authority.rfind(':');
+        if (colon != std::string::npos) hostEnd = colon;
+        host = authority.substr(0, hostEnd);
+    }
+
+    port = defaultPort;
+    if (colon == std::string::npos || colon + 1 == authority.size()) return !host.empty();
+
+    unsigned long value = 0;
+    for (std::size_t i = colon + 1; i < authority.size(); ++i) {
+        if (!std::isdigit(static_cast<unsigned char>(authority[i]))) return false;
+        value = value * 10 + static_cast<unsigned long>(authority[i] - '0');
+        if (value > 65535) return false;
+    }
+    if (value == 0) return false;
+    port = static_cast<unsigned short>(value);
+    return !host.empty();
+}
+
+std::size_t spiderForUrl(const std::string& url, std::size_t spiderCount)
+{
+    if (spiderCount <= 1) return 0;
+    return static_cast<std::size_t>(fnv1a64(urlHost(url)) % spiderCount);
+}
+
+CrawlExchange::CrawlExchange(const std::vector<std::string>& peers, std::size_t self,
+    std::size_t batchSize, int flushMs, int probeMs, Handler onUrl, IdleCheck isIdle)
+    : m_self(self),
+    m_batchSize(std::max<std::size_t>(1, batchSize)),
+    m_flushMs(std::max(10, flushMs)),
+    m_probeMs(std::max(50, probeMs)),
+    m_onUrl(std::move(onUrl)),
+    m_isIdle(std::move(isIdle)),
+    m_senders(peers.size()),
+    m_epoch(newEpoch()),
+    m_acceptor(m_recvIoc)
+{
+    if (self >= peers.size()) throw std::invalid_argument("spider_id is out of range of spider_peers");
+
+    tcp::resolver resolver(m_recvIoc);
+    for (auto& address : peers) {
+        auto colon = address.rfind(':');
+        if (colon == std::string::npos) throw std::runtime_error("Spider peer address must be host:port: " + address);
+
+        Peer peer;
+        peer.address = address;
+        peer.host = address.substr(0, colon);
+        peer.port = address.substr(colon + 1);
+        for (auto& entry : resolver.resolve(peer.host, peer.port)) m_allowed.push_back(entry.endpoint().address());
+        m_peers.push_back(std::move(peer));
+    }
+
+    //      spider_peers,    
+    tcp::endpoint endpoint = resolver.resolve(m_peers[m_self].host, m_peers[m_self].port).begin()->endpoint();
+    m_acceptor.open(endpoint.protocol());
+    m_acceptor.set_option(net::socket_base::reuse_address(true));
+    m_acceptor.bind(endpoint);
+    m_acceptor.listen();
+    accept();
+
+    std::cout << "[Crawl] Spider " << m_self << " of " << m_peers.size()
+        << " listening on " << endpoint << std::endl;
+
+    m_receiver = std::thread([this] { m_recvIoc.run(); });
+    m_sender = std::thread(&CrawlExchange::sendLoop, this);
+}
+
+CrawlExchange::~CrawlExchange()
+{
+    stop();
+}
+
+std::size_t CrawlExchange::ownerOf(const std::string& url) const
+{
+    return spiderForUrl(url, m_peers.size());
+}
+
+void CrawlExchange::forward(std::size_t peer, const std::string& url, int depth)
+{
+    if (url.size() + 16 > kMaxLineBytes || url.find_first_of("\t\r\n") != std::string::npos) return;
+
+    std::lock_guard<std::mutex> lg(m_mutex);
+    if (m_stop) return;
+    if (m_forwarded.size() >= kMaxForwarded) m_forwarded.clear();
+    if (!m_forwarded.insert(url).second) return;
+
+    Peer& p = m_peers[peer];
+    p.queue += std::to_string(depth);
+    p.queue += '\t';
+    p.queue += url;
+    p.queue += '\n';
+    if (++p.queued >= m_batchSize) {
+        m_batchReady = true;
+        m_cv.notify_all();
+    }
+}
+
+void CrawlExchange::waitForTermination()
+{
+    std::unique_lock<std::mutex> lk(m_mutex);
+    m_cv.wait(lk, [this] { return m_terminated || m_stop; });
+}
+
+void CrawlExchange::stop()
+{
+    {
+        std::lock_guard<std::mutex> lg(m_mutex);
+        if (m_stop) return;
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    if (m_sender.joinable()) m_sender.join();
+
+    m_recvIoc.stop();
+    if (m_receiver.joinable()) m_receiver.join();
+
+    //     ;      
+    std::size_t lost = 0;
+    for (auto& p : m_peers) lost += p.queued + p.batchLines;
+    if (lost > 0) std::cerr << "[Crawl] Stopped before the crawl finished, " << lost << " links were not delivered" << std::endl;
+}
+
+void CrawlExchange::sendLoop()
+{
+    auto nextProbe = std::chrono::steady_clock::now() + std::chrono::milliseconds(m_probeMs);
+    std::unique_lock<std::mutex> lk(m_mutex);
+    while (!m_stop) {
+        //  ,      
+        m_cv.wait_for(lk, std::chrono::milliseconds(m_flushMs), [this] { return m_stop || m_batchReady; });
+        m_batchReady = false;
+        const bool coordinator = m_self == 0 && !m_terminated && !m_stop;
+        lk.unlock();
+
+        flush();
+        if (coordinator && std::chrono::steady_clock::now() >= nextProbe) {
+            if (detectTermination()) announceTermination();
+            nextProbe = std::chrono::steady_clock::now() + std::chrono::milliseconds(m_probeMs);
+        }
+        lk.lock();
+    }
+    lk.unlock();
+    flush();
+}
+
+void CrawlExchange::flush()
+{
+    for (std::size_t i = 0; i < m_peers.size(); ++i) {
+        if (i == m_self) continue;
+        Peer& peer = m_peers[i];
+
+        std::string data;
+        std::uint64_t seq = 0;
+        std::size_t lines = 0;
+        {
+            std::lock_guard<std::mutex> lg(m_mutex);
+            if (peer.batch.empty()) {
+                if (peer.queue.empty()) continue;
+                peer.batch.swap(peer.queue);
+                peer.batchLines = peer.queued;
+                peer.batchSeq = peer.nextSeq++;
+                peer.queued = 0;
+            }
+            seq = peer.batchSeq;
+            lines = peer.batchLines;
+            data = "B " + std::to_string(m_self) + ' ' + std::to_string(m_epoch) + ' ' + std::to_string(seq) + ' '
+                + std::to_string(lines) + '\n' + peer.batch;
+        }
+
+        std::string answer;
+        bool ok = request(peer, data, answer) && answer == "A " + std::to_string(seq);
+
+        std::lock_guard<std::mutex> lg(m_mutex);
+        if (ok) {
+            peer.batch.clear();
+            peer.batchLines = 0;
+            peer.failures = 0;
+            ++m_sentBatches;
+            continue;
+        }
+        //   :       
+        if (peer.failures++ % kFailureReportEvery == 0) {
+            std::cerr << "[Crawl] Spider " << peer.address << " has not acknowledged " << lines << " links, will retry" << std::endl;
+        }
+    }
+}
+
+bool CrawlExchange::request(Peer& peer, const std::string& data, std::string& answer)
+{
+    //     , m_sendIoc  
+    beast::error_code ec;
+    if (!peer.stream) {
+        peer.stream = std::make_unique<beast::tcp_stream>(m_sendIoc);
+        tcp::resolver resolver(m_sendIoc);
+        auto endpoints = resolver.resolve(peer.host, peer.port, ec);
+        if (!ec) {
+            peer.stream->expires_after(std::chrono::milliseconds(kSendTimeoutMs));
+            peer.stream->async_connect(endpoints, [&ec](beast::error_code e, const tcp::endpoint&) { ec = e; });
+            m_sendIoc.restart();
+            m_sendIoc.run();
+        }
+    }
+
+    if (!ec) {
+        peer.stream->expires_after(std::chrono::milliseconds(kSendTimeoutMs));
+        net::async_write(*peer.stream, net::buffer(data), [&ec](beast::error_code e, std::size_t) { ec = e; });
+        m_sendIoc.restart();
+        m_sendIoc.run();
+    }
+
+    net::streambuf buf(kMaxLineBytes);
+    std::size_t n = 0;
+    if (!ec) {
+        peer.stream->expires_after(std::chrono::milliseconds(kSendTimeoutMs));
+        net::async_read_until(*peer.stream, buf, '\n', [&ec, &n](beast::error_code e, std::size_t size) { ec = e; n = size; });
+        m_sendIoc.restart();
+        m_sendIoc.run();
+    }
+
+    if (ec) {
+        peer.stream.reset();
+        return false;
+    }
+    answer = takeLine(buf, n);
+    return true;
+}
+
+CrawlExchange::Report CrawlExchange::report()
+{
+    Report r;
+    {
+        std::lock_guard<std::mutex> lg(m_mutex);
+        r.sent = m_sentBatches;
+        //     ,      -     
+        for (auto& s : m_senders) r.received += s.batches;
+    }
+    //     : ,  ,     
+    r.idle = m_isIdle();
+
+    std::lock_guard<std::mutex> lg(m_mutex);
+    for (auto& p : m_peers) {
+        if (!p.queue.empty() || !p.batch.empty()) r.idle = false;
+    }
+    return r;
+}
+
+bool CrawlExchange::probeRound(std::vector<Report>& reports)
+{
+    reports.assign(m_peers.size(), Report{});
+    reports[m_self] = report();
+    for (std::size_t i = 0; i < m_peers.size(); ++i) {
+        if (i == m_self) continue;
+
+        std::string answer;
+        std::vector<std::uint64_t> v;
+        if (!request(m_peers[i], "P\n", answer)) return false;
+        if (answer.compare(0, 2, "S ") != 0 || !parseNumbers(answer.substr(2), 3, v)) return false;
+        reports[i].idle = v[0] != 0;
+        reports[i].sent = v[1];
+        reports[i].received = v[2];
+    }
+    return true;
+}
+
+bool CrawlExchange::detectTermination()
+{
+    //      ,     :
+    //            ,  
+    std::vector<Report> first, second;
+    if (!probeRound(first)) return false;
+    for (auto& r : first) {
+        if (!r.idle) return false;
+    }
+    if (!probeRound(second) || first != second) return false;
+
+    std::uint64_t sent = 0, received = 0;
+    for (auto& r : second) {
+        sent += r.sent;
+        received += r.received;
+    }
+    return sent == received;
+}
+
+void CrawlExchange::announceTermination()
+{
+    std::cout << "[Crawl] All spiders are idle, finishing" << std::endl;
+    for (std::size_t i = 0; i < m_peers.size(); ++i) {
+        if (i == m_self) continue;
+
+        bool ok = false;
+        for (int attempt = 0; attempt < kTerminateAttempts && !ok; ++attempt) {
+            std::string answer;
+            ok = request(m_peers[i], "T\n", answer);
+            if (!ok) std::this_thread::sleep_for(std::chrono::milliseconds(m_flushMs));
+        }
+        if (!ok) std::cerr << "[Crawl] Spider " << m_peers[i].address << " did not receive the finish signal" << std::endl;
+    }
+    setTerminated();
+}
+
+void CrawlExchange::setTerminated()
+{
+    std::lock_guard<std::mutex> lg(m_mutex);
+    m_terminated = true;
+    m_cv.notify_all();
+}
+
+void CrawlExchange::accept()
+{
+    auto socket = std::make_shared<tcp::socket>(m_recvIoc);
+    m_acceptor.async_accept(*socket, [this, socket](beast::error_code ec) {
+        if (ec == net::error::operation_aborted) return;
+        if (ec) {
+            std::cerr << "[Crawl] Accept failed: " << ec.message() << std::endl;
+        }
+        else {
+            beast::error_code rec;
+            auto remote = socket->remote_endpoint(rec);
+            if (!rec && std::find(m_allowed.begin(), m_allowed.end(), remote.address()) != m_allowed.end()) {
+                readMessage(socket, std::make_shared<net::streambuf>(kMaxLineBytes));
+            }
+            else {
+                std::cerr << "[Crawl] Rejected connection from " << (rec ? std::string("unknown address") : remote.address().to_string()) << std::endl;
+                socket->close(rec);
+            }
+        }
+        accept();
+        });
+}
+
+void CrawlExchange::readMessage(std::shared_ptr<tcp::socket> socket, std::shared_ptr<net::streambuf> buf)
+{
+    net::async_read_until(*socket, *buf, '\n', [this, socket, buf](beast::error_code ec, std::size_t n) {
+        //      kMaxLineBytes
+        if (ec) return;
+
+        std::string line = takeLine(*buf, n);
+        std::vector<std::uint64_t> v;
+        if (line.compare(0, 2, "B ") == 0 && parseNumbers(line.substr(2), 4, v) && v[0] < m_peers.size() && v[0] != m_self) {
+            readBatch(socket, buf, static_cast<std::size_t>(v[0]), v[1], v[2], static_cast<std::size_t>(v[3]),
+                std::make_shared<std::vector<std::pair<std::string, int>>>());
+        }
+        else if (line == "P") {
+            Report r = report();
+            reply(socket, buf, "S " + std::to_string(r.idle ? 1 : 0) + ' ' + std::to_string(r.sent) + ' ' + std::to_string(r.received) + '\n');
+        }
+        else if (line == "T") {
+            setTerminated();
+            reply(socket, buf, "A 0\n");
+        }
+        //   ,  
+        });
+}
+
+void CrawlExchange::readBatch(std::shared_ptr<tcp::socket> socket, std::shared_ptr<net::streambuf> buf,
+    std::size_t from, std::uint64_t epoch, std::uint64_t seq, std::size_t left, std::shared_ptr<std::vector<std::pair<std::string, int>>> links)
+{
+    if (left == 0) {
+        bool fresh = false;
+        {
+            std::lock_guard<std::mutex> lg(m_mutex);
+            Sender& sender = m_senders[from];
+            if (sender.epoch != epoch) {
+                //  :  seq    1
+                sender = Sender{};
+                sender.epoch = epoch;
+            }
+            fresh = seq > sender.lastSeq;
+            if (fresh) sender.lastSeq = seq;
+        }
+        //  ,   ,  
+        if (fresh) {
+            for (auto& link : *links) m_onUrl(link.first, link.second);
+            std::lock_guard<std::mutex> lg(m_mutex);
+            if (m_senders[from].epoch == epoch) ++m_senders[from].batches;
+        }
+        reply(socket, buf, "A " + std::to_string(seq) + '\n');
+        return;
+    }
+
+    net::async_read_until(*socket, *buf, '\n', [this, socket, buf, from, epoch, seq, left, links](beast::error_code ec, std::size_t n) {
+        if (ec) return;
+
+        std::string line = takeLine(*buf, n);
+        auto tab = line.find('\t');
+        if (tab != std::string::npos) {
+            int depth = -1;
+            try { depth = std::stoi(line.substr(0, tab)); }
+            catch (const std::exception&) {}
+            if (depth >= 0) links->emplace_back(line.substr(tab + 1), depth);
+        }
+        readBatch(socket, buf, from, epoch, seq, left - 1, links);
+        });
+}
+
+void CrawlExchange::reply(std::shared_ptr<tcp::socket> socket, std::shared_ptr<net::streambuf> buf, std::string message)
+{
+    auto data = std::make_shared<std::string>(std::move(message));
+    net::async_write(*socket, net::buffer(*data), [this, socket, buf, data](beast::error_code ec, std::size_t) {
+        if (!ec) readMessage(socket, buf);
+        });
+}
@@ -0,0 +1,145 @@
+#pragma once
+#ifndef CRAWL_EXCHANGE_H
+#define CRAWL_EXCHANGE_H
+
+#include <boost/asio.hpp>
+#include <boost/beast/core/tcp_stream.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+//  URL      ,    (""  URL  http/https)
+std::string urlHost(const std::string& url);
+
+// "host"  "host:port" ( urlHost) ->   DNS  ;
+//    - defaultPort. false -   
+bool splitHostPort(const std::string& authority, unsigned short defaultPort, std::string& host, unsigned short& port);
+
+//  - URL:   ,    
+//   
+std::size_t spiderForUrl(const std::string& url, std::size_t spiderCount);
+
+//        .
+//            TCP:
+// "B from epoch seq count\n"  count  "depth\turl\n";   
+//  onUrl   "A seq\n".   ,
+//     ,     seq    .
+// epoch -  ,     :  
+//  seq   1,      seq.
+//
+//     0:    ("P\n" -> "S idle sent received\n")
+//   "T\n",      ,  
+//         .
+class CrawlExchange
+{
+public:
+    using Handler = std::function<void(const std::string& url, int depth)>;
+    // true -      (   )
+    using IdleCheck = std::function<bool()>;
+
+    // peers: "host:port"  , self -     .
+    //    self          
+    CrawlExchange(const std::vector<std::string>& peers, std::size_t self,
+        std::size_t batchSize, int flushMs, int probeMs, Handler onUrl, IdleCheck isIdle);
+    ~CrawlExchange();
+
+    std::size_t self() const { return m_self; }
+    std::size_t ownerOf(const std::string& url) const;
+
+    //     ;        
+    void forward(std::size_t peer, const std::string& url, int depth);
+
+    // ,     
+    void waitForTermination();
+
+    //  ;   (   )   
+    void stop();
+
+private:
+    struct Peer
+    {
+        std::string address;
+        std::string host;
+        std::string port;
+        std::string queue;
+        std::size_t queued = 0;
+        // , ,     
+        std::string batch;
+        std::size_t batchLines = 0;
+        std::uint64_t batchSeq = 0;
+        std::uint64_t nextSeq = 1;
+        int failures = 0;
+        std::unique_ptr<boost::beast::tcp_stream> stream;
+    };
+
+    struct Report
+    {
+        bool idle = false;
+        std::uint64_t sent = 0;
+        std::uint64_t received = 0;
+        bool operator==(const Report& o) const { return idle == o.idle && sent == o.sent && received == o.received; }
+    };
+
+    void sendLoop();
+    void flush();
+    bool request(Peer& peer, const std::string& data, std::string& reply);
+
+    Report report();
+    //  0:  ; false - - 
+    bool probeRound(std::vector<Report>& reports);
+    bool detectTermination();
+    void announceTermination();
+    void setTerminated();
+
+    void accept();
+    void readMessage(std::shared_ptr<boost::asio::ip::tcp::socket> socket, std::shared_ptr<boost::asio::streambuf> buf);
+    void readBatch(std::shared_ptr<boost::asio::ip::tcp::socket> socket, std::shared_ptr<boost::asio::streambuf> buf,
+        std::size_t from, std::uint64_t epoch, std::uint64_t seq, std::size_t left, std::shared_ptr<std::vector<std::pair<std::string, int>>> links);
+    void reply(std::shared_ptr<boost::asio::ip::tcp::socket> socket, std::shared_ptr<boost::asio::streambuf> buf, std::string message);
+
+    std::vector<Peer> m_peers;
+    std::size_t m_self;
+    std::size_t m_batchSize;
+    int m_flushMs;
+    int m_probeMs;
+    Handler m_onUrl;
+    IdleCheck m_isIdle;
+    //    spider_peers:    
+    std::vector<boost::asio::ip::address> m_allowed;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+    //   ;    (  )
+    std::unordered_set<std::string> m_forwarded;
+    std::uint64_t m_sentBatches = 0;
+    //   :  epoch,   seq      
+    struct Sender
+    {
+        std::uint64_t epoch = 0;
+        std::uint64_t lastSeq = 0;
+        std::uint64_t batches = 0;
+    };
+    std::vector<Sender> m_senders;
+    const std::uint64_t m_epoch;
+    bool m_batchReady = false;
+    bool m_terminated = false;
+    bool m_stop = false;
+
+    boost::asio::io_context m_sendIoc;
+    boost::asio::io_context m_recvIoc;
+    boost::asio::ip::tcp::acceptor m_acceptor;
+
+    std::thread m_sender;
+    std::thread m_receiver;
+};
+
+#endif // CRAWL_EXCHANGE_H
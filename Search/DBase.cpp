@@ -1,7 +1,23 @@
 #include "DBase.h"
+#include <algorithm>
 #include <iostream>
-#include <sstream>
 #include <stdexcept>
+#include <unordered_map>
+
+//      m_wordIds,    
+static const std::size_t kMaxCachedWords = 100000;
+static const int kSnippetChars = 240;
+
+static std::string toIdArrayLiteral(const std::vector<int>& ids)
+{
+    std::string arr = "{";
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        if (i > 0) arr += ",";
+        arr += std::to_string(ids[i]);
+    }
+    arr += "}";
+    return arr;
+}
 
 Database::Database(const std::string& connectionString)
     : m_connStr(connectionString),
@@ -11,6 +27,7 @@ Database::Database(const std::string& connectionString)
         throw std::runtime_error("Failed to open DB connection");
     }
     createTables();
+    prepareStatements();
 }
 
 Database::~Database() {}
@@ -45,6 +62,32 @@ void Database::createTables()
             )
         )");
 
+        txn.exec("ALTER TABLE DocumentWords ADD COLUMN IF NOT EXISTS positions BYTEA");
+        //    id ,   (document_id, word_id)    
+        txn.exec("CREATE INDEX IF NOT EXISTS documentwords_word_id_idx ON DocumentWords (word_id, document_id) INCLUDE (frequency)");
+        txn.exec("ALTER TABLE Documents ADD COLUMN IF NOT EXISTS simhash BIGINT");
+        //   :      
+        txn.exec("CREATE SEQUENCE IF NOT EXISTS documents_simhash_seq");
+        txn.exec("ALTER TABLE Documents ADD COLUMN IF NOT EXISTS simhash_seq BIGINT");
+        txn.exec("CREATE INDEX IF NOT EXISTS documents_simhash_seq_idx ON Documents (simhash_seq)");
+
+        txn.exec(R"(
+            CREATE TABLE IF NOT EXISTS DocumentAliases (
+                url TEXT PRIMARY KEY,
+                document_id INT NOT NULL REFERENCES Documents(id) ON DELETE CASCADE
+            )
+        )");
+
+        // word -   , surface -    
+        txn.exec("ALTER TABLE Words ADD COLUMN IF NOT EXISTS surface TEXT");
+
+        txn.exec(R"(
+            CREATE TABLE IF NOT EXISTS IndexInfo (
+                name TEXT PRIMARY KEY,
+                value TEXT NOT NULL
+            )
+        )");
+
         txn.commit();
         std::cout << "[DB] Tables created or already exist." << std::endl;
     }
@@ -54,6 +97,87 @@ void Database::createTables()
     }
 }
 
+void Database::prepareStatements()
+{
+    // anchor -       , term -    
+    // ("happy"  "happi"):      
+    auto snippetAround = [](const std::string& anchor, const std::string& term) {
+        return "substring(d.content from greatest(1, coalesce(nullif(strpos(d.content, " + anchor + "), 0), strpos(d.content, " + term + ")) - " +
+            std::to_string(kSnippetChars / 3) + ") for " + std::to_string(kSnippetChars) + ")";
+    };
+    const std::string snippet = snippetAround("$3", "$4");
+
+    // ,     ($1 - id   ),   
+    const std::string top = R"(
+        SELECT document_id, SUM(frequency) AS relevance
+        FROM DocumentWords
+        WHERE word_id = ANY($1::int[])
+        GROUP BY document_id
+        HAVING COUNT(*) = cardinality($1::int[])
+    )";
+
+    m_conn->prepare("word_ids", "SELECT id, word FROM Words WHERE word = ANY($1::text[])");
+
+    m_conn->prepare("search_count", "SELECT COUNT(*) FROM (" + top + ") t");
+
+    m_conn->prepare("search_docs",
+        "SELECT d.url, d.title, " + snippet + " AS snippet, t.relevance "
+        "FROM (" + top + " ORDER BY relevance DESC LIMIT $2) t "
+        "JOIN Documents d ON d.id = t.document_id "
+        "ORDER BY t.relevance DESC");
+
+    //     (, );   -     
+    m_conn->prepare("search_positions",
+        "SELECT d.id, d.url, d.title, "
+        "CASE WHEN dw.word_id = ($1::int[])[1] THEN " + snippet + " END AS snippet, "
+        "t.relevance, dw.word_id, dw.positions "
+        "FROM (" + top + " ORDER BY relevance DESC LIMIT $2) t "
+        "JOIN Documents d ON d.id = t.document_id "
+        "JOIN DocumentWords dw ON dw.document_id = t.document_id AND dw.word_id = ANY($1::int[]) "
+        "ORDER BY t.relevance DESC, d.id");
+
+    // $2 -  id  , $3 -  
+    m_conn->prepare("scan_positions",
+        "SELECT dw.document_id AS id, t.relevance, dw.word_id, dw.positions "
+        "FROM (SELECT document_id, SUM(frequency) AS relevance FROM DocumentWords "
+        "WHERE word_id = ANY($1::int[]) AND document_id > $2 "
+        "GROUP BY document_id HAVING COUNT(*) = cardinality($1::int[]) "
+        "ORDER BY document_id LIMIT $3) t "
+        "JOIN DocumentWords dw ON dw.document_id = t.document_id AND dw.word_id = ANY($1::int[]) "
+        "ORDER BY dw.document_id");
+
+    m_conn->prepare("documents_by_id",
+        "SELECT d.id, d.url, d.title, " + snippetAround("$2", "$3") + " AS snippet "
+        "FROM Documents d WHERE d.id = ANY($1::int[])");
+}
+
+bool Database::lookupWordIds(pqxx::transaction_base& txn, const std::vector<std::string>& words, std::vector<int>& ids)
+{
+    std::vector<std::string> missing;
+    for (auto& w : words) {
+        if (m_wordIds.find(w) == m_wordIds.end()) missing.push_back(w);
+    }
+
+    if (!missing.empty()) {
+        if (m_wordIds.size() + missing.size() > kMaxCachedWords) m_wordIds.clear();
+
+        //    , pqxx   
+        pqxx::result r = txn.exec_prepared("word_ids", missing);
+        for (auto row : r) {
+            m_wordIds[row["word"].as<std::string>()] = row["id"].as<int>();
+        }
+    }
+
+    ids.clear();
+    for (auto& w : words) {
+        auto it = m_wordIds.find(w);
+        //    :     
+        if (it == m_wordIds.end()) return false;
+        ids.push_back(it->second);
+    }
+    return true;
+}
+
 int Database::insertDocument(const std::string& url, const std::string& title, const std::string& content)
 {
     pqxx::work txn(*m_conn);
@@ -68,6 +192,34 @@ int Database::insertDocument(const std::string& url, const std::string& title, c
     return id;
 }
 
+int Database::insertDocument(const std::string& url, const std::string& title, const std::string& content, std::uint64_t simhash)
+{
+    pqxx::work txn(*m_conn);
+    pqxx::result r = txn.exec_params(
+        "INSERT INTO Documents (url, title, content, simhash, simhash_seq) VALUES ($1, $2, $3, $4, nextval('documents_simhash_seq')) "
+        "ON CONFLICT (url) DO UPDATE SET title=EXCLUDED.title, content=EXCLUDED.content, simhash=EXCLUDED.simhash, "
+        "simhash_seq=EXCLUDED.simhash_seq "
+        "RETURNING id",
+        url, title, content, static_cast<std::int64_t>(simhash)
+    );
+    int id = r[0][0].as<int>();
+    txn.commit();
+    return id;
+}
+
+void Database::insertAlias(const std::string& url, int document_id)
+{
+    pqxx::work txn(*m_conn);
+    //         
+    txn.exec_params(
+        "INSERT INTO DocumentAliases (url, document_id) "
+        "SELECT $1::text, $2::int WHERE NOT EXISTS (SELECT 1 FROM Documents WHERE url = $1 AND id = $2) "
+        "ON CONFLICT (url) DO UPDATE SET document_id = EXCLUDED.document_id",
+        url, document_id
+    );
+    txn.commit();
+}
+
 int Database::insertWord(const std::string& word)
 {
     pqxx::work txn(*m_conn);
@@ -83,13 +235,13 @@ void Database::insertDocumentWord(int document_id, int word_id, int frequency)
     txn.commit();
 }
 
-int Database::insertWordTxn(pqxx::work& txn, const std::string& word)
+int Database::insertWordTxn(pqxx::work& txn, const std::string& word, const std::string& surface)
 {
     pqxx::result r = txn.exec_params(
-        "INSERT INTO Words (word) VALUES ($1) "
-        "ON CONFLICT (word) DO UPDATE SET word=EXCLUDED.word "
+        "INSERT INTO Words (word, surface) VALUES ($1, NULLIF($2, '')) "
+        "ON CONFLICT (word) DO UPDATE SET surface = COALESCE(Words.surface, EXCLUDED.surface) "
         "RETURNING id",
-        word
+        word, surface
     );
     return r[0][0].as<int>();
 }
@@ -119,6 +271,20 @@ int Database::GetWordId(const std::string& word)
     return r[0][0].as<int>();
 }
 
+void Database::insertDocumentWordTxn(pqxx::work& txn, int document_id, int word_id, int frequency, const Positions& positions)
+{
+    txn.exec_params(
+        "INSERT INTO DocumentWords (document_id, word_id, frequency, positions) VALUES ($1, $2, $3, $4) "
+        "ON CONFLICT (document_id, word_id) DO UPDATE SET frequency = EXCLUDED.frequency, positions = EXCLUDED.positions",
+        document_id, word_id, frequency, encodePositions(positions)
+    );
+}
+
+void Database::deleteDocumentWordsTxn(pqxx::work& txn, int document_id)
+{
+    txn.exec_params("DELETE FROM DocumentWords WHERE document_id = $1", document_id);
+}
+
 std::vector<std::pair<std::string, int>> Database::GetDocumentsByWord(const std::string& word)
 {
     std::vector<std::pair<std::string, int>> results;
@@ -158,52 +324,313 @@ std::vector<std::pair<std::string, int>> Database::GetWordsByDocument(int docume
     return results;
 }
 
-std::vector<SearchResult> Database::SearchDocumentsByWords(const std::vector<std::string>& words)
+std::vector<std::pair<int, std::uint64_t>> Database::GetDocumentFingerprints(std::int64_t afterSeq, std::int64_t& lastSeq)
+{
+    std::vector<std::pair<int, std::uint64_t>> results;
+    pqxx::work txn(*m_conn);
+
+    pqxx::result r = afterSeq < 0
+        ? txn.exec("SELECT id, simhash, simhash_seq FROM Documents WHERE simhash IS NOT NULL ORDER BY simhash_seq NULLS FIRST")
+        : txn.exec_params("SELECT id, simhash, simhash_seq FROM Documents WHERE simhash_seq > $1 AND simhash IS NOT NULL "
+            "ORDER BY simhash_seq", afterSeq);
+
+    results.reserve(r.size());
+    for (auto row : r) {
+        results.emplace_back(row["id"].as<int>(), static_cast<std::uint64_t>(row["simhash"].as<std::int64_t>()));
+        if (!row["simhash_seq"].is_null()) lastSeq = std::max(lastSeq, row["simhash_seq"].as<std::int64_t>());
+    }
+    return results;
+}
+
+std::vector<std::pair<std::string, int>> Database::GetWordDocumentCounts()
+{
+    std::vector<std::pair<std::string, int>> results;
+    pqxx::work txn(*m_conn);
+
+    pqxx::result r = txn.exec(R"(
+        SELECT COALESCE(w.surface, w.word) AS word, COUNT(*) AS documents
+        FROM Words w
+        JOIN DocumentWords dw ON w.id = dw.word_id
+        GROUP BY w.id
+    )");
+
+    results.reserve(r.size());
+    for (auto row : r) {
+        results.emplace_back(row["word"].as<std::string>(), row["documents"].as<int>());
+    }
+    return results;
+}
+
+std::vector<SearchResult> Database::SearchDocumentsByWords(const std::vector<std::string>& words, int timeoutMs, long long* total,
+    const std::string& anchor)
 {
     std::vector<SearchResult> results;
+    if (total) *total = 0;
+
     if (words.empty()) return results;
 
-    std::ostringstream arr;
-    arr << "{";
-    for (size_t i = 0; i < words.size(); ++i) {
-        std::string w = words[i];
-        size_t pos = 0;
-        while ((pos = w.find('"', pos)) != std::string::npos) { w.replace(pos, 1, "\\\""); pos += 2; }
-        arr << "\"" << w << "\"";
-        if (i + 1 < words.size()) arr << ",";
-    }
-    arr << "}";
+    // ,    ,     ,   
+    pqxx::read_transaction txn(*m_conn);
+    std::vector<int> ids;
+    if (!lookupWordIds(txn, words, ids)) return results;
 
-    std::string sql = R"(
-        SELECT d.url, d.title, SUM(dw.frequency) AS relevance
-        FROM Documents d
-        JOIN DocumentWords dw ON d.id = dw.document_id
-        JOIN Words w ON dw.word_id = w.id
-        WHERE w.word = ANY($1)
-        GROUP BY d.url, d.title
-        HAVING COUNT(DISTINCT w.word) = array_length($1,1)
-        ORDER BY relevance DESC
-        LIMIT 10
-    )";
+    // ,       
+    pqxx::pipeline pipe(txn);
+    if (timeoutMs > 0) {
+        pipe.insert("SET LOCAL statement_timeout = " + std::to_string(timeoutMs));
+    }
+    std::string arr = txn.quote(toIdArrayLiteral(ids));
+    auto docsQuery = pipe.insert("EXECUTE search_docs(" + arr + ", 10, " + txn.quote(anchor.empty() ? words[0] : anchor) + ", " + txn.quote(words[0]) + ")");
+    auto countQuery = pipe.insert("EXECUTE search_count(" + arr + ")");
 
-    pqxx::work txn(*m_conn);
-    pqxx::result r = txn.exec_params(sql, arr.str());
+    pqxx::result r = pipe.retrieve(docsQuery);
+    pqxx::result count = pipe.retrieve(countQuery);
+    pipe.complete();
     txn.commit();
 
     for (auto row : r) {
         SearchResult sr;
         sr.url = row["url"].as<std::string>();
         sr.title = row["title"].is_null() ? std::string() : row["title"].as<std::string>();
+        sr.snippet = row["snippet"].is_null() ? std::string() : row["snippet"].as<std::string>();
         sr.rank = row["relevance"].as<int>();
         results.push_back(sr);
     }
+    if (total && !count.empty()) *total = count[0][0].as<long long>();
+
+    return results;
+}
+
+std::vector<SearchCandidate> Database::SearchDocumentsWithPositions(const std::vector<std::string>& words, int limit, int timeoutMs, long long* total,
+    const std::string& anchor)
+{
+    std::vector<SearchCandidate> results;
+    if (total) *total = 0;
+
+    if (words.empty()) return results;
+
+    pqxx::read_transaction txn(*m_conn);
+    std::vector<int> ids;
+    if (!lookupWordIds(txn, words, ids)) return results;
+
+    pqxx::pipeline pipe(txn);
+    if (timeoutMs > 0) {
+        pipe.insert("SET LOCAL statement_timeout = " + std::to_string(timeoutMs));
+    }
+    std::string arr = txn.quote(toIdArrayLiteral(ids));
+    auto posQuery = pipe.insert("EXECUTE search_positions(" + arr + ", " + std::to_string(limit) + ", " +
+        txn.quote(anchor.empty() ? words[0] : anchor) + ", " + txn.quote(words[0]) + ")");
+    auto countQuery = pipe.insert("EXECUTE search_count(" + arr + ")");
+
+    pqxx::result pos = pipe.retrieve(posQuery);
+    pqxx::result count = pipe.retrieve(countQuery);
+    pipe.complete();
+    txn.commit();
+
+    std::unordered_map<int, std::size_t> byId;
+    for (auto row : pos) {
+        int id = row["id"].as<int>();
+        auto it = byId.find(id);
+        if (it == byId.end()) {
+            SearchCandidate c;
+            c.url = row["url"].as<std::string>();
+            c.title = row["title"].is_null() ? std::string() : row["title"].as<std::string>();
+            c.rank = row["relevance"].as<int>();
+            c.positions.resize(words.size());
+            it = byId.emplace(id, results.size()).first;
+            results.push_back(std::move(c));
+        }
+
+        SearchCandidate& c = results[it->second];
+        if (!row["snippet"].is_null()) c.snippet = row["snippet"].as<std::string>();
+        if (row["positions"].is_null()) continue;
+
+        int wordId = row["word_id"].as<int>();
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            if (ids[i] == wordId) c.positions[i] = decodePositions(row["positions"].as<PositionBytes>());
+        }
+    }
+    if (total && !count.empty()) *total = count[0][0].as<long long>();
+
+    return results;
+}
+
+std::vector<SearchCandidate> Database::ScanDocumentsWithPositions(const std::vector<std::string>& words, int afterId, int limit, int timeoutMs)
+{
+    std::vector<SearchCandidate> results;
+
+    if (words.empty()) return results;
+
+    pqxx::read_transaction txn(*m_conn);
+    std::vector<int> ids;
+    if (!lookupWordIds(txn, words, ids)) return results;
+
+    pqxx::pipeline pipe(txn);
+    if (timeoutMs > 0) {
+        pipe.insert("SET LOCAL statement_timeout = " + std::to_string(timeoutMs));
+    }
+    auto scanQuery = pipe.insert("EXECUTE scan_positions(" + txn.quote(toIdArrayLiteral(ids)) + ", " +
+        std::to_string(afterId) + ", " + std::to_string(limit) + ")");
+
+    pqxx::result pos = pipe.retrieve(scanQuery);
+    pipe.complete();
+    txn.commit();
 
+    //     id:  -  
+    for (auto row : pos) {
+        int id = row["id"].as<int>();
+        if (results.empty() || results.back().id != id) {
+            SearchCandidate c;
+            c.id = id;
+            c.rank = row["relevance"].as<int>();
+            c.positions.resize(words.size());
+            results.push_back(std::move(c));
+        }
+        if (row["positions"].is_null()) continue;
+
+        SearchCandidate& c = results.back();
+        int wordId = row["word_id"].as<int>();
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            if (ids[i] == wordId) c.positions[i] = decodePositions(row["positions"].as<PositionBytes>());
+        }
+    }
+    return results;
+}
+
+std::vector<SearchResult> Database::GetSearchResults(const std::vector<SearchCandidate>& docs, const std::string& term, const std::string& anchor, int timeoutMs)
+{
+    std::vector<SearchResult> results;
+    if (docs.empty()) return results;
+
+    std::vector<int> ids;
+    for (auto& d : docs) ids.push_back(d.id);
+
+    pqxx::read_transaction txn(*m_conn);
+    pqxx::pipeline pipe(txn);
+    if (timeoutMs > 0) {
+        pipe.insert("SET LOCAL statement_timeout = " + std::to_string(timeoutMs));
+    }
+    auto docsQuery = pipe.insert("EXECUTE documents_by_id(" + txn.quote(toIdArrayLiteral(ids)) + ", " +
+        txn.quote(anchor.empty() ? term : anchor) + ", " + txn.quote(term) + ")");
+
+    pqxx::result r = pipe.retrieve(docsQuery);
+    pipe.complete();
+    txn.commit();
+
+    std::unordered_map<int, SearchResult> byId;
+    for (auto row : r) {
+        SearchResult sr;
+        sr.url = row["url"].as<std::string>();
+        sr.title = row["title"].is_null() ? std::string() : row["title"].as<std::string>();
+        sr.snippet = row["snippet"].is_null() ? std::string() : row["snippet"].as<std::string>();
+        byId.emplace(row["id"].as<int>(), std::move(sr));
+    }
+    for (auto& d : docs) {
+        auto it = byId.find(d.id);
+        if (it == byId.end()) continue;
+        it->second.rank = d.rank;
+        results.push_back(std::move(it->second));
+    }
     return results;
 }
 
 void Database::clearAll()
 {
     pqxx::work txn(*m_conn);
-    txn.exec("TRUNCATE DocumentWords, Words, Documents RESTART IDENTITY CASCADE");
+    txn.exec("TRUNCATE DocumentAliases, DocumentWords, Words, Documents, IndexInfo RESTART IDENTITY CASCADE");
     txn.commit();
 }
+
+std::string Database::GetIndexInfo(const std::string& name)
+{
+    pqxx::work txn(*m_conn);
+    pqxx::result r = txn.exec_params("SELECT value FROM IndexInfo WHERE name = $1", name);
+    if (r.empty()) return {};
+    return r[0][0].as<std::string>();
+}
+
+void Database::SetIndexInfo(const std::string& name, const std::string& value)
+{
+    pqxx::work txn(*m_conn);
+    txn.exec_params(
+        "INSERT INTO IndexInfo (name, value) VALUES ($1, $2) "
+        "ON CONFLICT (name) DO UPDATE SET value = EXCLUDED.value",
+        name, value
+    );
+    txn.commit();
+}
+
+void Database::beginPostingsRebuild()
+{
+    pqxx::work txn(*m_conn);
+    //   ; Words  : id     
+    txn.exec("DROP TABLE IF EXISTS DocumentWords_new");
+    txn.exec(R"(
+        CREATE TABLE DocumentWords_new (
+            document_id INT NOT NULL REFERENCES Documents(id) ON DELETE CASCADE,
+            word_id INT NOT NULL REFERENCES Words(id) ON DELETE CASCADE,
+            frequency INT NOT NULL,
+            positions BYTEA,
+            PRIMARY KEY(document_id, word_id)
+        )
+    )");
+    txn.commit();
+}
+
+void Database::insertRebuiltDocumentWordTxn(pqxx::work& txn, int document_id, int word_id, int frequency, const Positions& positions)
+{
+    txn.exec_params(
+        "INSERT INTO DocumentWords_new (document_id, word_id, frequency, positions) VALUES ($1, $2, $3, $4)",
+        document_id, word_id, frequency, encodePositions(positions)
+    );
+}
+
+void Database::finishPostingsRebuild(const std::string& name, const std::string& value)
+{
+    {
+        //    ,      
+        pqxx::work txn(*m_conn);
+        txn.exec("CREATE INDEX documentwords_new_word_id_idx ON DocumentWords_new (word_id, document_id) INCLUDE (frequency)");
+        txn.exec("ANALYZE DocumentWords_new");
+        txn.commit();
+    }
+
+    //        ,    ;
+    //   Postgres     
+    pqxx::work txn(*m_conn);
+    txn.exec("DROP TABLE DocumentWords");
+    txn.exec("ALTER TABLE DocumentWords_new RENAME TO DocumentWords");
+    txn.exec("ALTER TABLE DocumentWords RENAME CONSTRAINT documentwords_new_pkey TO documentwords_pkey");
+    txn.exec("ALTER TABLE DocumentWords RENAME CONSTRAINT documentwords_new_document_id_fkey TO documentwords_document_id_fkey");
+    txn.exec("ALTER TABLE DocumentWords RENAME CONSTRAINT documentwords_new_word_id_fkey TO documentwords_word_id_fkey");
+    txn.exec("ALTER INDEX documentwords_new_word_id_idx RENAME TO documentwords_word_id_idx");
+    txn.exec_params(
+        "INSERT INTO IndexInfo (name, value) VALUES ($1, $2) "
+        "ON CONFLICT (name) DO UPDATE SET value = EXCLUDED.value",
+        name, value
+    );
+    txn.commit();
+}
+
+std::vector<std::pair<int, std::string>> Database::GetDocumentContents(int afterId, int limit)
+{
+    std::vector<std::pair<int, std::string>> results;
+    pqxx::work txn(*m_conn);
+
+    pqxx::result r = txn.exec_params(
+        "SELECT id, content FROM Documents WHERE id > $1 ORDER BY id LIMIT $2",
+        afterId, limit
+    );
+
+    results.reserve(r.size());
+    for (auto row : r) {
+        results.emplace_back(row["id"].as<int>(), row["content"].is_null() ? std::string() : row["content"].as<std::string>());
+    }
+    return results;
+}
+
+void Database::updateSimhashTxn(pqxx::work& txn, int document_id, std::uint64_t simhash)
+{
+    txn.exec_params("UPDATE Documents SET simhash = $2, simhash_seq = nextval('documents_simhash_seq') WHERE id = $1",
+        document_id, static_cast<std::int64_t>(simhash));
+}
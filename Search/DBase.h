@@ -1,15 +1,26 @@
 #pragma once
+#include "PositionList.h"
+
 #include <pqxx/pqxx>
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 struct SearchResult {
     std::string url;
     std::string title;
+    std::string snippet;
     int rank;
 };
 
+//    :      
+struct SearchCandidate : SearchResult {
+    int id = 0;
+    std::vector<Positions> positions;
+};
+
 class Database {
 public:
     explicit Database(const std::string& connectionString);
@@ -18,28 +29,76 @@ public:
     void createTables();
 
     int insertDocument(const std::string& url, const std::string& title, const std::string& content);
+    //   SimHash   -
+    int insertDocument(const std::string& url, const std::string& title, const std::string& content, std::uint64_t simhash);
+    // url - -   
+    void insertAlias(const std::string& url, int document_id);
 
     //  
     int insertWord(const std::string& word);
     void insertDocumentWord(int document_id, int word_id, int frequency);
 
     //        
-    int insertWordTxn(pqxx::work& txn, const std::string& word);
+    // surface -   ,     word ( )
+    int insertWordTxn(pqxx::work& txn, const std::string& word, const std::string& surface = {});
     void insertDocumentWordTxn(pqxx::work& txn, int document_id, int word_id, int frequency);
+    void insertDocumentWordTxn(pqxx::work& txn, int document_id, int word_id, int frequency, const Positions& positions);
+    //      
+    void deleteDocumentWordsTxn(pqxx::work& txn, int document_id);
 
     int GetDocumentId(const std::string& url);
     int GetWordId(const std::string& word);
 
     std::vector<std::pair<std::string, int>> GetDocumentsByWord(const std::string& word);
     std::vector<std::pair<std::string, int>> GetWordsByDocument(int document_id);
-    std::vector<SearchResult> SearchDocumentsByWords(const std::vector<std::string>& words);
+    //  (id, simhash),   afterSeq (afterSeq < 0 - ),   ;
+    // lastSeq     
+    std::vector<std::pair<int, std::uint64_t>> GetDocumentFingerprints(std::int64_t afterSeq, std::int64_t& lastSeq);
+    //     ,     ( )
+    std::vector<std::pair<std::string, int>> GetWordDocumentCounts();
+    // timeoutMs > 0       Postgres;
+    // total -      ;   
+    //  anchor (   ),       -  words[0]
+    std::vector<SearchResult> SearchDocumentsByWords(const std::vector<std::string>& words, int timeoutMs = 0, long long* total = nullptr,
+        const std::string& anchor = {});
+    //  limit        +   (  words)
+    std::vector<SearchCandidate> SearchDocumentsWithPositions(const std::vector<std::string>& words, int limit, int timeoutMs = 0, long long* total = nullptr,
+        const std::string& anchor = {});
+    //  :  limit      id > afterId   id,
+    //  id, rank   -     ,     
+    std::vector<SearchCandidate> ScanDocumentsWithPositions(const std::vector<std::string>& words, int afterId, int limit, int timeoutMs = 0);
+    // url,     anchor ( term)    (   , rank )
+    std::vector<SearchResult> GetSearchResults(const std::vector<SearchCandidate>& docs, const std::string& term, const std::string& anchor, int timeoutMs = 0);
 
     void clearAll();
 
+    //    (,   );  -  
+    std::string GetIndexInfo(const std::string& name);
+    void SetIndexInfo(const std::string& name, const std::string& value);
+
+    //  :      DocumentWords_new, 
+    //    ; finish     name = value
+    //  .     id
+    void beginPostingsRebuild();
+    void insertRebuiltDocumentWordTxn(pqxx::work& txn, int document_id, int word_id, int frequency, const Positions& positions);
+    void finishPostingsRebuild(const std::string& name, const std::string& value);
+    std::vector<std::pair<int, std::string>> GetDocumentContents(int afterId, int limit);
+    void updateSimhashTxn(pqxx::work& txn, int document_id, std::uint64_t simhash);
+
     //   connection ( Spider)
     pqxx::connection& connection() { return *m_conn; }
+    const std::string& connectionString() const { return m_connStr; }
 
 private:
+    //       
+    void prepareStatements();
+    // id    words; false  -    .
+    //       txn -   
+    bool lookupWordIds(pqxx::transaction_base& txn, const std::vector<std::string>& words, std::vector<int>& ids);
+
     std::string m_connStr;
     std::unique_ptr<pqxx::connection> m_conn;
+    //  -> id; Words   (    ),
+    //   id  
+    std::unordered_map<std::string, int> m_wordIds;
 };
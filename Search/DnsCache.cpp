@@ -0,0 +1,91 @@
+#include "DnsCache.h"
+
+#include <boost/asio/post.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+#include <memory>
+
+using tcp = boost::asio::ip::tcp;
+
+namespace {
+
+//        
+const std::size_t kSweepThreshold = 4096;
+
+} // namespace
+
+DnsCache::DnsCache(int ttlSec, int negativeTtlSec, std::size_t threads)
+    : m_ttl(std::max(0, ttlSec)),
+    m_negativeTtl(std::max(0, negativeTtlSec)),
+    m_pool(std::max<std::size_t>(1, threads))
+{
+}
+
+DnsCache::~DnsCache()
+{
+    m_pool.join();
+    if (m_lookups > 0) {
+        std::cout << "[DNS] " << m_lookups << " lookups, " << m_hits << " served from cache" << std::endl;
+    }
+}
+
+std::shared_future<DnsCache::Endpoints> DnsCache::lookup(const std::string& host)
+{
+    std::string key = host;
+    std::transform(key.begin(), key.end(), key.begin(),
+        [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+    std::shared_future<Endpoints> result;
+    auto promise = std::make_shared<std::promise<Endpoints>>();
+    {
+        std::lock_guard<std::mutex> lg(m_mutex);
+        auto now = std::chrono::steady_clock::now();
+        ++m_lookups;
+
+        auto it = m_entries.find(key);
+        if (it != m_entries.end() && (it->second.pending || now < it->second.expires)) {
+            //  ,    ,   
+            ++m_hits;
+            result = it->second.result;
+        }
+        else {
+            if (it == m_entries.end() && m_entries.size() >= kSweepThreshold) sweep(now);
+            Entry& entry = m_entries[key];
+            entry.result = promise->get_future().share();
+            entry.pending = true;
+            result = entry.result;
+
+            boost::asio::post(m_pool, [this, key, host, promise]() {
+                boost::system::error_code ec;
+                tcp::resolver resolver(m_pool);
+                Endpoints endpoints;
+                for (auto& entry : resolver.resolve(host, std::string(), ec)) endpoints.push_back(entry.endpoint());
+                {
+                    std::lock_guard<std::mutex> lg(m_mutex);
+                    Entry& e = m_entries[key];
+                    e.pending = false;
+                    e.expires = std::chrono::steady_clock::now() + (ec ? m_negativeTtl : m_ttl);
+                }
+                if (ec) promise->set_exception(std::make_exception_ptr(boost::system::system_error(ec, "resolve " + host)));
+                else promise->set_value(std::move(endpoints));
+                });
+        }
+    }
+    return result;
+}
+
+DnsCache::Endpoints DnsCache::withPort(Endpoints endpoints, unsigned short port)
+{
+    for (auto& e : endpoints) e.port(port);
+    return endpoints;
+}
+
+void DnsCache::sweep(std::chrono::steady_clock::time_point now)
+{
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (!it->second.pending && it->second.expires <= now) it = m_entries.erase(it);
+        else ++it;
+    }
+}
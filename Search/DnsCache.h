@@ -0,0 +1,58 @@
+#pragma once
+#ifndef DNS_CACHE_H
+#define DNS_CACHE_H
+
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/thread_pool.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//       DNS.
+//      ,     ,
+//     ;          .    ttlSec ,
+//  - negativeTtlSec (getaddrinfo   TTL ).
+//   -    :      .
+class DnsCache
+{
+public:
+    using Endpoints = std::vector<boost::asio::ip::tcp::endpoint>;
+
+    DnsCache(int ttlSec, int negativeTtlSec, std::size_t threads);
+    ~DnsCache();
+
+    //  :  (  0)  boost::system::system_error   future.
+    //     -      
+    std::shared_future<Endpoints> lookup(const std::string& host);
+    //       port
+    static Endpoints withPort(Endpoints endpoints, unsigned short port);
+    //   
+    Endpoints resolve(const std::string& host, unsigned short port) { return withPort(lookup(host).get(), port); }
+
+private:
+    struct Entry
+    {
+        std::shared_future<Endpoints> result;
+        std::chrono::steady_clock::time_point expires;
+        bool pending = true;
+    };
+
+    void sweep(std::chrono::steady_clock::time_point now);
+
+    std::chrono::seconds m_ttl;
+    std::chrono::seconds m_negativeTtl;
+
+    std::mutex m_mutex;
+    std::unordered_map<std::string, Entry> m_entries;
+    std::size_t m_hits = 0;
+    std::size_t m_lookups = 0;
+
+    boost::asio::thread_pool m_pool;
+};
+
+#endif // DNS_CACHE_H
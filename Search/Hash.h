@@ -0,0 +1,20 @@
+#pragma once
+#ifndef HASH_H
+#define HASH_H
+
+#include <cstdint>
+#include <string_view>
+
+// FNV-1a:    std::hash       
+// ,         
+inline std::uint64_t fnv1a64(std::string_view s)
+{
+    std::uint64_t h = 1469598103934665603ull;
+    for (unsigned char c : s) {
+        h ^= c;
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+#endif // HASH_H
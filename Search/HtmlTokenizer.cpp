@@ -0,0 +1,226 @@
+#include "HtmlTokenizer.h"
+
+#include <cctype>
+#include <cstring>
+
+namespace {
+
+const std::size_t kMaxTagSize = 8192;
+const std::size_t kMaxTitleSize = 1024;
+
+bool isSpace(char c)
+{
+    return std::isspace(static_cast<unsigned char>(c)) != 0;
+}
+
+char lower(char c)
+{
+    return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+}
+
+std::string trim(const std::string& s)
+{
+    std::size_t b = 0, e = s.size();
+    while (b < e && isSpace(s[b])) ++b;
+    while (e > b && isSpace(s[e - 1])) --e;
+    return s.substr(b, e - b);
+}
+
+std::string findAttribute(const std::string& tag, std::size_t pos, const std::string& wanted)
+{
+    const std::size_t size = tag.size();
+    while (pos < size) {
+        while (pos < size && (isSpace(tag[pos]) || tag[pos] == '/')) ++pos;
+
+        std::size_t nameStart = pos;
+        while (pos < size && !isSpace(tag[pos]) && tag[pos] != '=' && tag[pos] != '/') ++pos;
+        std::string name;
+        for (std::size_t i = nameStart; i < pos; ++i) name.push_back(lower(tag[i]));
+
+        while (pos < size && isSpace(tag[pos])) ++pos;
+
+        std::string value;
+        if (pos < size && tag[pos] == '=') {
+            ++pos;
+            while (pos < size && isSpace(tag[pos])) ++pos;
+            if (pos < size && (tag[pos] == '"' || tag[pos] == '\'')) {
+                char q = tag[pos++];
+                std::size_t e = tag.find(q, pos);
+                if (e == std::string::npos) e = size;
+                value = tag.substr(pos, e - pos);
+                pos = e + 1;
+            }
+            else {
+                std::size_t s = pos;
+                while (pos < size && !isSpace(tag[pos])) ++pos;
+                value = tag.substr(s, pos - s);
+            }
+        }
+        else if (pos == nameStart) {
+            ++pos;
+        }
+
+        if (name == wanted) return trim(value);
+    }
+    return {};
+}
+
+std::string decodeAmp(std::string s)
+{
+    std::size_t pos = 0;
+    while ((pos = s.find("&amp;", pos)) != std::string::npos) {
+        s.erase(pos + 1, 4);
+        ++pos;
+    }
+    return s;
+}
+
+} // namespace
+
+HtmlTokenizer::HtmlTokenizer()
+    : m_state(State::Text), m_quote(0), m_match(0), m_inTitle(false), m_titleDone(false)
+{
+}
+
+void HtmlTokenizer::feed(const char* data, std::size_t size)
+{
+    const char* p = data;
+    const char* end = data + size;
+
+    while (p < end) {
+        switch (m_state) {
+        case State::Text: {
+            const char* lt = static_cast<const char*>(std::memchr(p, '<', static_cast<std::size_t>(end - p)));
+            const char* stop = lt ? lt : end;
+            m_normalizer.append(p, static_cast<std::size_t>(stop - p), m_text);
+            if (m_inTitle) appendTitle(p, stop);
+            if (!lt) {
+                p = end;
+                break;
+            }
+            p = lt + 1;
+            m_state = State::Tag;
+            m_tag.clear();
+            m_quote = 0;
+            break;
+        }
+        case State::Tag:
+            for (; p < end; ++p) {
+                char c = *p;
+                // "a < b" -  ,   
+                if (m_tag.empty() && !std::isalpha(static_cast<unsigned char>(c)) && c != '/' && c != '!' && c != '?') {
+                    m_normalizer.boundary(m_text);
+                    if (m_inTitle) appendTitle("<", "<" + 1);
+                    m_state = State::Text;
+                    break;
+                }
+                if (m_quote) {
+                    if (c == m_quote) m_quote = 0;
+                }
+                else if (c == '"' || c == '\'') {
+                    m_quote = c;
+                }
+                else if (c == '>') {
+                    ++p;
+                    onTag();
+                    break;
+                }
+                if (m_tag.size() < kMaxTagSize) m_tag.push_back(c);
+                if (m_tag.size() == 3 && m_tag == "!--") {
+                    ++p;
+                    m_state = State::Comment;
+                    m_match = 0;
+                    break;
+                }
+            }
+            break;
+        case State::Comment:
+            for (; p < end; ++p) {
+                char c = *p;
+                if (c == '-') {
+                    if (m_match < 2) ++m_match;
+                }
+                else if (c == '>' && m_match == 2) {
+                    ++p;
+                    m_normalizer.boundary(m_text);
+                    m_state = State::Text;
+                    break;
+                }
+                else {
+                    m_match = 0;
+                }
+            }
+            break;
+        case State::RawText:
+            for (; p < end; ++p) {
+                char c = lower(*p);
+                if (c == m_rawEnd[m_match]) {
+                    if (++m_match == m_rawEnd.size()) {
+                        ++p;
+                        m_state = State::Tag;
+                        m_tag = m_rawEnd.substr(1);
+                        m_quote = 0;
+                        break;
+                    }
+                }
+                else {
+                    m_match = (c == '<') ? 1 : 0;
+                }
+            }
+            break;
+        }
+    }
+}
+
+void HtmlTokenizer::finish()
+{
+    m_normalizer.finish(m_text);
+}
+
+void HtmlTokenizer::onTag()
+{
+    m_state = State::Text;
+    m_normalizer.boundary(m_text);
+
+    std::size_t i = 0;
+    bool closing = false;
+    if (i < m_tag.size() && m_tag[i] == '/') {
+        closing = true;
+        ++i;
+    }
+    std::string name;
+    while (i < m_tag.size() && (std::isalnum(static_cast<unsigned char>(m_tag[i])) || m_tag[i] == '-')) {
+        name.push_back(lower(m_tag[i++]));
+    }
+
+    if (name == "title") {
+        if (closing) {
+            m_inTitle = false;
+            m_titleDone = m_titleDone || !m_title.empty();
+        }
+        else if (!m_titleDone) {
+            m_inTitle = true;
+        }
+        return;
+    }
+    if (closing) return;
+
+    if ((name == "script" || name == "style") && m_tag.back() != '/') {
+        m_state = State::RawText;
+        m_rawEnd = "</" + name;
+        m_match = 0;
+        return;
+    }
+
+    if (name == "a") {
+        std::string href = findAttribute(m_tag, i, "href");
+        if (!href.empty()) m_links.push_back(decodeAmp(href));
+    }
+}
+
+void HtmlTokenizer::appendTitle(const char* begin, const char* end)
+{
+    std::size_t room = kMaxTitleSize > m_title.size() ? kMaxTitleSize - m_title.size() : 0;
+    std::size_t n = static_cast<std::size_t>(end - begin);
+    m_title.append(begin, n < room ? n : room);
+}
@@ -0,0 +1,46 @@
+#pragma once
+#ifndef HTML_TOKENIZER_H
+#define HTML_TOKENIZER_H
+
+#include "TextNormalizer.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+//   HTML:       ,
+//      .   - ,
+//  <a href>     , <script>  <style>.
+class HtmlTokenizer
+{
+public:
+    HtmlTokenizer();
+
+    void feed(const char* data, std::size_t size);
+    void finish();
+
+    const std::string& title() const { return m_title; }
+    const std::string& text() const { return m_text; }
+    const std::vector<std::string>& links() const { return m_links; }
+
+private:
+    enum class State { Text, Tag, Comment, RawText };
+
+    void onTag();
+    void appendTitle(const char* begin, const char* end);
+
+    State m_state;
+    std::string m_tag;          //     '<'  '>'
+    char m_quote;               //    
+    std::string m_rawEnd;       // "</script"  "</style"
+    std::size_t m_match;        //   m_rawEnd / "-->"  
+    bool m_inTitle;
+    bool m_titleDone;
+
+    TextNormalizer m_normalizer;
+    std::string m_text;
+    std::string m_title;
+    std::vector<std::string> m_links;
+};
+
+#endif // HTML_TOKENIZER_H
@@ -0,0 +1,42 @@
+#include "PhraseScan.h"
+
+#include <algorithm>
+
+PhraseScanResult scanPhrases(const CandidateFetch& fetch, const PhraseMatch& match, int batchSize, std::size_t limit,
+    std::chrono::steady_clock::time_point deadline)
+{
+    auto better = [](const SearchCandidate& a, const SearchCandidate& b) { return a.rank != b.rank ? a.rank > b.rank : a.id < b.id; };
+
+    PhraseScanResult result;
+    batchSize = std::max(1, batchSize);
+    std::vector<SearchCandidate> batch;
+    int afterId = 0;
+    for (;;)
+    {
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        batch.clear();
+        if (left.count() <= 0 || !fetch(afterId, batchSize, static_cast<int>(left.count()), batch))
+        {
+            result.complete = false;
+            break;
+        }
+
+        for (auto& c : batch)
+        {
+            SearchCandidate found;
+            if (!match(c, found.rank)) continue;
+            found.id = c.id;
+            ++result.matches;
+            result.top.push_back(std::move(found));
+        }
+
+        //      limit
+        std::size_t keep = std::min(limit, result.top.size());
+        std::partial_sort(result.top.begin(), result.top.begin() + static_cast<std::ptrdiff_t>(keep), result.top.end(), better);
+        result.top.resize(keep);
+
+        if (batch.size() < static_cast<std::size_t>(batchSize)) break;
+        afterId = batch.back().id;
+    }
+    return result;
+}
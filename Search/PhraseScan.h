@@ -0,0 +1,29 @@
+#pragma once
+#ifndef PHRASE_SCAN_H
+#define PHRASE_SCAN_H
+
+#include "DBase.h"
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+//         , 
+//   ,   id,       deadline
+struct PhraseScanResult
+{
+    std::vector<SearchCandidate> top;   //  limit   (id  rank)
+    long long matches = 0;              //     
+    bool complete = true;               // false -    
+};
+
+// fetch(afterId, limit, timeoutMs, batch):    id; false -    timeoutMs
+using CandidateFetch = std::function<bool(int afterId, int limit, int timeoutMs, std::vector<SearchCandidate>& batch)>;
+// match(c, rank):      , rank -  
+using PhraseMatch = std::function<bool(const SearchCandidate& c, int& rank)>;
+
+PhraseScanResult scanPhrases(const CandidateFetch& fetch, const PhraseMatch& match, int batchSize, std::size_t limit,
+    std::chrono::steady_clock::time_point deadline);
+
+#endif // PHRASE_SCAN_H
@@ -0,0 +1,98 @@
+#include "PositionList.h"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <utility>
+
+PositionBytes encodePositions(const Positions& positions)
+{
+    PositionBytes out;
+    out.reserve(positions.size() * 2);
+    std::uint32_t prev = 0;
+    for (std::uint32_t p : positions) {
+        std::uint32_t delta = p - prev;
+        prev = p;
+        while (delta >= 0x80) {
+            out.push_back(static_cast<std::byte>((delta & 0x7F) | 0x80));
+            delta >>= 7;
+        }
+        out.push_back(static_cast<std::byte>(delta));
+    }
+    return out;
+}
+
+Positions decodePositions(const PositionBytes& bytes)
+{
+    Positions out;
+    out.reserve(bytes.size());
+    std::uint32_t prev = 0, value = 0;
+    unsigned shift = 0;
+    for (std::byte b : bytes) {
+        std::uint32_t v = std::to_integer<std::uint32_t>(b);
+        value |= (v & 0x7F) << shift;
+        if (v & 0x80) {
+            shift += 7;
+            if (shift > 28) return out; //  
+            continue;
+        }
+        prev += value;
+        out.push_back(prev);
+        value = 0;
+        shift = 0;
+    }
+    return out;
+}
+
+bool containsPhrase(const std::vector<const Positions*>& lists, const std::vector<std::uint32_t>& offsets)
+{
+    if (lists.empty() || lists.size() != offsets.size()) return false;
+    for (auto* l : lists) if (l->empty()) return false;
+
+    std::vector<std::size_t> cursor(lists.size(), 0);
+    for (std::uint32_t first : *lists[0]) {
+        if (first < offsets[0]) continue;
+        std::uint32_t start = first - offsets[0];
+
+        bool all = true;
+        for (std::size_t i = 1; i < lists.size() && all; ++i) {
+            const Positions& l = *lists[i];
+            std::uint32_t want = start + offsets[i];
+            //  ,  start   -   
+            auto it = std::lower_bound(l.begin() + static_cast<std::ptrdiff_t>(cursor[i]), l.end(), want);
+            cursor[i] = static_cast<std::size_t>(it - l.begin());
+            if (it == l.end()) return false;
+            all = (*it == want);
+        }
+        if (all) return true;
+    }
+    return false;
+}
+
+std::uint32_t minCoverSpan(const std::vector<const Positions*>& lists)
+{
+    if (lists.empty()) return 0;
+    for (auto* l : lists) if (l->empty()) return 0;
+
+    // k- :         
+    using Item = std::pair<std::uint32_t, std::size_t>;
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item>> heap;
+    std::vector<std::size_t> cursor(lists.size(), 0);
+    std::uint32_t maxPos = 0;
+    for (std::size_t i = 0; i < lists.size(); ++i) {
+        heap.emplace((*lists[i])[0], i);
+        maxPos = std::max(maxPos, (*lists[i])[0]);
+    }
+
+    std::uint32_t best = UINT32_MAX;
+    for (;;) {
+        auto [minPos, i] = heap.top();
+        heap.pop();
+        best = std::min(best, maxPos - minPos + 1);
+        if (++cursor[i] == lists[i]->size()) break;
+        std::uint32_t next = (*lists[i])[cursor[i]];
+        maxPos = std::max(maxPos, next);
+        heap.emplace(next, i);
+    }
+    return best;
+}
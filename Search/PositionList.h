@@ -0,0 +1,25 @@
+#pragma once
+#ifndef POSITION_LIST_H
+#define POSITION_LIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//       DocumentWords.positions (BYTEA):
+//   ,  - varint (7   ).
+using PositionBytes = std::basic_string<std::byte>;
+using Positions = std::vector<std::uint32_t>;
+
+PositionBytes encodePositions(const Positions& positions);
+Positions decodePositions(const PositionBytes& bytes);
+
+//    p,   lists[i]  p + offsets[i]   i
+bool containsPhrase(const std::vector<const Positions*>& lists, const std::vector<std::uint32_t>& offsets);
+
+//   ,        ;
+// 0  -  
+std::uint32_t minCoverSpan(const std::vector<const Positions*>& lists);
+
+#endif // POSITION_LIST_H
@@ -1,12 +1,24 @@
 #include "Config.h"
 #include "DBase.h"
+#include "PhraseScan.h"
+#include "ShardCoordinator.h"
+#include "SuggestIndex.h"
+#include "TextAnalyzer.h"
+#include "TextNormalizer.h"
 
 #include <boost/beast/core.hpp>
 #include <boost/beast/http.hpp>
 #include <boost/beast/version.hpp>
 #include <boost/asio.hpp>
 
+#include <algorithm>
+#include <cstdio>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <thread>
 #include <vector>
@@ -35,7 +47,25 @@ static std::string make_search_form()
 )";
 }
 
-static std::string make_results_page(const std::string& query, const std::vector<SearchResult>& results, const std::string& message = {}) 
+static std::string html_escape(const std::string& s)
+{
+    std::string out;
+    out.reserve(s.size());
+    for (char c : s) {
+        switch (c) {
+        case '<': out += "&lt;"; break;
+        case '>': out += "&gt;"; break;
+        case '&': out += "&amp;"; break;
+        case '"': out += "&quot;"; break;
+        default: out += c;
+        }
+    }
+    return out;
+}
+
+// total < 0 -    
+static std::string make_results_page(const std::string& query, const std::vector<SearchResult>& results,
+    const std::string& message = {}, long long total = -1) 
 {
     std::ostringstream oss;
     oss << "<!doctype html><html><head><meta charset='utf-8'><title>Results</title></head><body>";
@@ -47,11 +77,16 @@ static std::string make_results_page(const std::string& query, const std::vector
         oss << "<p>No results found.</p>";
     }
     else {
+        if (total >= 0) {
+            oss << "<p>Matching documents: " << total << "</p>";
+        }
         oss << "<ol>";
         for (auto& r : results) {
             oss << "<li><a href=\"" << r.url << "\">"
                 << (r.title.empty() ? r.url : r.title)
-                << "</a> (score: " << r.rank << ")</li>";
+                << "</a> (score: " << r.rank << ")";
+            if (!r.snippet.empty()) oss << "<br><small>" << html_escape(r.snippet) << "</small>";
+            oss << "</li>";
         }
         oss << "</ol>";
     }
@@ -83,37 +118,386 @@ static std::string url_decode(const std::string& s)
     return ret;
 }
 
-static std::vector<std::string> splitQueryWords(const std::string& q) 
+// : (   SearchQuery::words,    )
+using QueryPhrase = std::vector<std::pair<std::size_t, std::uint32_t>>;
+
+struct SearchQuery
+{
+    std::vector<std::string> words;
+    // words[i]   (   ) -   
+    std::vector<std::string> surfaces;
+    std::vector<QueryPhrase> phrases;
+};
+
+//      ,   "" -    .
+//     ,    
+static SearchQuery parseQuery(const std::string& q, const TextAnalyzer& analyzer) 
 {
-    std::vector<std::string> res;
-    std::istringstream iss(q);
-    std::string w;
-    while (iss >> w) {
-        std::string clean;
-        for (char c : w) {
-            if (std::isalnum(static_cast<unsigned char>(c))) {
-                clean.push_back(std::tolower(static_cast<unsigned char>(c)));
+    SearchQuery query;
+    std::istringstream segments(q);
+    std::string segment;
+    for (bool quoted = false; std::getline(segments, segment, '"'); quoted = !quoted) {
+        std::istringstream iss(normalizeText(segment));
+        std::string w;
+        QueryPhrase phrase;
+        for (std::uint32_t offset = 0; iss >> w; ++offset) {
+            std::string surface = w;
+            w = analyzer.term(w);
+            if (w.empty()) continue;
+
+            auto it = std::find(query.words.begin(), query.words.end(), w);
+            std::size_t idx = static_cast<std::size_t>(it - query.words.begin());
+            if (it == query.words.end()) {
+                if (query.words.size() >= 4) continue; //  4 
+                query.words.push_back(w);
+                query.surfaces.push_back(surface);
             }
+            if (quoted) phrase.emplace_back(idx, offset);
         }
-        if (clean.size() >= 3 && clean.size() <= 32) {
-            res.push_back(clean);
+        if (phrase.size() > 1) query.phrases.push_back(std::move(phrase));
+    }
+    return query;
+}
+
+//       
+static bool matches_phrases(const SearchCandidate& c, const SearchQuery& query)
+{
+    for (auto& phrase : query.phrases) {
+        std::vector<const Positions*> lists;
+        std::vector<std::uint32_t> offsets;
+        for (auto& term : phrase) {
+            lists.push_back(&c.positions[term.first]);
+            offsets.push_back(term.second);
+        }
+        if (!containsPhrase(lists, offsets)) return false;
+    }
+    return true;
+}
+
+//          
+static int proximity_rank(const SearchCandidate& c, const SearchQuery& query)
+{
+    const int proximityBoost = 10;
+    const std::uint32_t n = static_cast<std::uint32_t>(query.words.size());
+
+    int rank = c.rank;
+    if (n > 1) {
+        std::vector<const Positions*> all;
+        for (auto& p : c.positions) all.push_back(&p);
+        std::uint32_t span = minCoverSpan(all);
+        if (span > 0) {
+            rank += static_cast<int>(proximityBoost * n / (std::max(span, n) - n + 1));
         }
-        if (res.size() >= 4) break; //  4 
     }
+    return rank;
+}
+
+//  ,   ,   ,
+//        
+static std::vector<SearchResult> rank_by_positions(const std::vector<SearchCandidate>& candidates, const SearchQuery& query, std::size_t limit)
+{
+    std::vector<SearchResult> results;
+    for (auto& c : candidates) {
+        if (!matches_phrases(c, query)) continue;
+
+        SearchResult r = c;
+        r.rank = proximity_rank(c, query);
+        results.push_back(r);
+    }
+
+    std::stable_sort(results.begin(), results.end(),
+        [](const SearchResult& a, const SearchResult& b) { return a.rank > b.rank; });
+    if (results.size() > limit) results.resize(limit);
+    return results;
+}
+
+static std::string query_param(beast::string_view target, const std::string& name)
+{
+    auto qpos = target.find('?');
+    if (qpos == beast::string_view::npos) return {};
+    std::string query(target.substr(qpos + 1));
+
+    std::istringstream iss(query);
+    std::string pair;
+    while (std::getline(iss, pair, '&')) {
+        auto eq = pair.find('=');
+        if (pair.substr(0, eq) == name) {
+            return eq == std::string::npos ? std::string() : url_decode(pair.substr(eq + 1));
+        }
+    }
+    return {};
+}
+
+static std::string json_escape(const std::string& s)
+{
+    std::string out;
+    out.reserve(s.size() + 2);
+    for (unsigned char c : s) {
+        switch (c) {
+        case '"': out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            if (c < 0x20) {
+                char buf[8];
+                std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                out += buf;
+            }
+            else {
+                out.push_back(static_cast<char>(c));
+            }
+        }
+    }
+    return out;
+}
+
+//    ,     
+static std::string make_suggest_json(const std::string& q, const SuggestIndex& index, std::size_t limit)
+{
+    std::string normalized = normalizeText(q);
+    std::string head, prefix = normalized;
+    auto sp = normalized.find_last_of(' ');
+    if (sp != std::string::npos) {
+        head = normalized.substr(0, sp + 1);
+        prefix = normalized.substr(sp + 1);
+    }
+
+    std::ostringstream oss;
+    oss << "{\"q\":\"" << json_escape(q) << "\",\"suggestions\":[";
+    if (!prefix.empty()) {
+        bool first = true;
+        for (auto& s : index.complete(prefix, limit)) {
+            if (!first) oss << ",";
+            first = false;
+            oss << "{\"text\":\"" << json_escape(head + s.first) << "\",\"documents\":" << s.second << "}";
+        }
+    }
+    oss << "]}";
+    return oss.str();
+}
+
+// ------------------   -------------------
+//    :   slots   ,
+//   maxQueued   ,   
+class QueryGate
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    QueryGate(Database& primary, std::size_t slots, std::size_t maxQueued)
+        : m_maxQueued(maxQueued), m_waiting(0)
+    {
+        m_free.push_back(&primary);
+        for (std::size_t i = 1; i < slots; ++i) {
+            m_owned.push_back(std::make_unique<Database>(primary.connectionString()));
+            m_free.push_back(m_owned.back().get());
+        }
+    }
+
+    // nullptr -        until
+    Database* acquire(clock::time_point until)
+    {
+        std::unique_lock<std::mutex> lk(m_mutex);
+        if (m_free.empty()) {
+            if (m_waiting >= m_maxQueued) return nullptr;
+            ++m_waiting;
+            bool ok = m_cv.wait_until(lk, until, [this] { return !m_free.empty(); });
+            --m_waiting;
+            if (!ok) return nullptr;
+        }
+        Database* db = m_free.back();
+        m_free.pop_back();
+        return db;
+    }
+
+    void release(Database* db)
+    {
+        {
+            std::lock_guard<std::mutex> lg(m_mutex);
+            m_free.push_back(db);
+        }
+        m_cv.notify_one();
+    }
+
+private:
+    std::size_t m_maxQueued;
+    std::size_t m_waiting;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::vector<Database*> m_free;
+    std::vector<std::unique_ptr<Database>> m_owned;
+};
+
+class QueryLease
+{
+public:
+    QueryLease(QueryGate& gate, QueryGate::clock::time_point until)
+        : m_gate(gate), m_db(gate.acquire(until)) {}
+    ~QueryLease() { if (m_db) m_gate.release(m_db); }
+
+    QueryLease(const QueryLease&) = delete;
+    QueryLease& operator=(const QueryLease&) = delete;
+
+    explicit operator bool() const { return m_db != nullptr; }
+    Database& db() { return *m_db; }
+
+private:
+    QueryGate& m_gate;
+    Database* m_db;
+};
+
+static http::response<http::string_body> make_overload_response(unsigned version, int retryAfterSec, const std::string& message)
+{
+    http::response<http::string_body> res(http::status::service_unavailable, version);
+    res.set(http::field::server, BOOST_BEAST_VERSION_STRING);
+    res.set(http::field::content_type, "text/html; charset=utf-8");
+    res.set(http::field::retry_after, std::to_string(retryAfterSec));
+    res.keep_alive(false);
+    res.body() = "<h1>Service unavailable</h1><p>" + message + "</p><p><a href='/'>Back</a></p>";
+    res.prepare_payload();
     return res;
 }
 
+//      io_context ,
+//    tcp_stream
+template <class Op>
+static beast::error_code run_with_timeout(net::io_context& ioc, beast::tcp_stream& stream, int timeoutMs, Op&& op)
+{
+    beast::error_code result;
+    stream.expires_after(std::chrono::milliseconds(timeoutMs));
+    op([&result](beast::error_code ec, std::size_t) { result = ec; });
+    ioc.restart();
+    ioc.run();
+    return result;
+}
+
+// ------------------  -------------------
+struct ServerContext
+{
+    const Config& cfg;
+    const TextAnalyzer& analyzer;
+    QueryGate* gate;                    //     ( .. )
+    SuggestService* suggest;
+    const ShardCoordinator* shards;     // :  -
+};
+
+enum class SearchStatus { Ok, Busy };
+
+//           
+static const int kFetchReserveShare = 5;
+
+//       ; message -    ,
+// total -       (  -   )
+static SearchStatus execute_search(ServerContext& ctx, const std::string& q, const SearchQuery& query,
+    QueryGate::clock::time_point deadline, std::vector<SearchResult>& results, long long& total, std::string& message)
+{
+    total = 0;
+    if (ctx.shards)
+    {
+        std::size_t failed = 0, partial = 0;
+        results = ctx.shards->search(q, 10, failed, total, partial);
+        if (failed > 0)
+        {
+            message = "Partial results: " + std::to_string(failed) + " of "
+                + std::to_string(ctx.shards->size()) + " shards did not respond.";
+        }
+        else if (partial > 0)
+        {
+            message = "Phrase search timed out on " + std::to_string(partial) + " of "
+                + std::to_string(ctx.shards->size()) + " shards: results and count are incomplete.";
+        }
+        return SearchStatus::Ok;
+    }
+
+    auto queueDeadline = std::min(deadline,
+        QueryGate::clock::now() + std::chrono::milliseconds(ctx.cfg.GetQueueTimeoutMs()));
+    QueryLease lease(*ctx.gate, queueDeadline);
+    if (!lease) return SearchStatus::Busy;
+
+    auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - QueryGate::clock::now());
+    int timeoutMs = std::max<int>(1, static_cast<int>(left.count()));
+    if (query.words.size() == 1 && query.phrases.empty())
+    {
+        results = lease.db().SearchDocumentsByWords(query.words, timeoutMs, &total, query.surfaces[0]);
+    }
+    else if (query.phrases.empty())
+    {
+        //     ,     
+        auto candidates = lease.db().SearchDocumentsWithPositions(query.words, ctx.cfg.GetPhraseCandidates(), timeoutMs, &total, query.surfaces[0]);
+        results = rank_by_positions(candidates, query, 10);
+    }
+    else
+    {
+        //     deadline:    url   
+        auto fetchReserve = std::chrono::milliseconds(std::max(1, ctx.cfg.GetRequestTimeoutMs() / kFetchReserveShare));
+        auto fetch = [&](int afterId, int limit, int batchTimeoutMs, std::vector<SearchCandidate>& batch) {
+            try
+            {
+                batch = lease.db().ScanDocumentsWithPositions(query.words, afterId, limit, batchTimeoutMs);
+                return true;
+            }
+            catch (const pqxx::sql_error& e)
+            {
+                // 57014 - query_canceled:     statement_timeout
+                if (e.sqlstate() == "57014") return false;
+                throw;
+            }
+        };
+        auto match = [&](const SearchCandidate& c, int& rank) {
+            if (!matches_phrases(c, query)) return false;
+            rank = proximity_rank(c, query);
+            return true;
+        };
+        PhraseScanResult scan = scanPhrases(fetch, match, ctx.cfg.GetPhraseCandidates(), 10, deadline - fetchReserve);
+        if (!scan.complete) message = "Phrase search timed out: results and count are incomplete.";
+
+        total = scan.matches;
+        left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - QueryGate::clock::now());
+        results = lease.db().GetSearchResults(scan.top, query.words[0], query.surfaces[0], std::max<int>(1, static_cast<int>(left.count())));
+    }
+    return SearchStatus::Ok;
+}
+
 // ------------------   -------------------
-void handle_session(tcp::socket socket, Database& db)
+void handle_session(net::io_context& ioc, tcp::socket socket, ServerContext& ctx)
 {
-    beast::error_code ec;
+    const Config& cfg = ctx.cfg;
+    beast::tcp_stream stream(std::move(socket));
     beast::flat_buffer buffer;
 
-    http::request<http::string_body> req;
-    http::read(socket, buffer, req, ec);
-    if (ec) return;
+    http::request_parser<http::string_body> parser;
+    parser.header_limit(static_cast<std::uint32_t>(cfg.GetMaxHeaderBytes()));
+    parser.body_limit(static_cast<std::uint64_t>(cfg.GetMaxBodyBytes()));
+
+    beast::error_code ec = run_with_timeout(ioc, stream, cfg.GetReadTimeoutMs(), [&](auto handler) {
+        http::async_read(stream, buffer, parser, std::move(handler));
+        });
 
     http::response<http::string_body> res;
+    unsigned version = parser.get().version();
+
+    if (ec == http::error::header_limit || ec == http::error::body_limit)
+    {
+        res = http::response<http::string_body>(
+            ec == http::error::header_limit ? http::status::request_header_fields_too_large : http::status::payload_too_large,
+            version);
+        res.set(http::field::content_type, "text/plain; charset=utf-8");
+        res.keep_alive(false);
+        res.body() = "Request too large";
+        res.prepare_payload();
+        run_with_timeout(ioc, stream, cfg.GetReadTimeoutMs(), [&](auto handler) {
+            http::async_write(stream, res, std::move(handler));
+            });
+        stream.socket().shutdown(tcp::socket::shutdown_send, ec);
+        return;
+    }
+    if (ec) return;
+
+    http::request<http::string_body> req = parser.release();
+    auto deadline = QueryGate::clock::now() + std::chrono::milliseconds(cfg.GetRequestTimeoutMs());
+    beast::string_view path = req.target().substr(0, req.target().find('?'));
 
     try
     {
@@ -126,6 +510,39 @@ void handle_session(tcp::socket socket, Database& db)
             res.body() = make_search_form();
             res.prepare_payload();
         }
+        else if (ctx.suggest && req.method() == http::verb::get && path == "/suggest")
+        {
+            //    ,    
+            res = http::response<http::string_body>(http::status::ok, req.version());
+            res.set(http::field::server, BOOST_BEAST_VERSION_STRING);
+            res.set(http::field::content_type, "application/json; charset=utf-8");
+            res.set(http::field::cache_control, "public, max-age=60");
+            res.body() = make_suggest_json(query_param(req.target(), "q"), *ctx.suggest->snapshot(),
+                static_cast<std::size_t>(std::max(0, cfg.GetSuggestLimit())));
+            res.prepare_payload();
+        }
+        else if (!ctx.shards && req.method() == http::verb::get && path == "/shard/search")
+        {
+            //  : top-k     
+            std::string q = query_param(req.target(), "q");
+            SearchQuery query = parseQuery(q, ctx.analyzer);
+            std::vector<SearchResult> results;
+            long long total = 0;
+            std::string message;
+            if (!query.words.empty() &&
+                execute_search(ctx, q, query, deadline, results, total, message) == SearchStatus::Busy)
+            {
+                res = make_overload_response(req.version(), cfg.GetRetryAfterSec(), "Shard is busy.");
+            }
+            else
+            {
+                res = http::response<http::string_body>(http::status::ok, req.version());
+                res.set(http::field::content_type, "text/tab-separated-values; charset=utf-8");
+                //   message      
+                res.body() = formatShardResults(results, total, !message.empty());
+                res.prepare_payload();
+            }
+        }
         else if (req.method() == http::verb::post && (req.target() == "/search" || req.target() == "/"))
         {
             //    (q=...)
@@ -137,20 +554,26 @@ void handle_session(tcp::socket socket, Database& db)
                 q = url_decode(body.substr(pos + 2));
             }
 
-            auto words = splitQueryWords(q);
-            if (words.empty())
+            SearchQuery query = parseQuery(q, ctx.analyzer);
+            std::vector<SearchResult> results;
+            long long total = 0;
+            std::string message;
+            if (query.words.empty())
             {
                 res = http::response<http::string_body>(http::status::ok, req.version());
                 res.set(http::field::content_type, "text/html; charset=utf-8");
-                res.body() = make_results_page(q, {}, "Empty or invalid query (words 3..32 chars, up to 4).");
+                res.body() = make_results_page(q, {}, "Empty or invalid query (words 3..32 chars except stop words, up to 4).");
                 res.prepare_payload();
             }
-            else 
+            else if (execute_search(ctx, q, query, deadline, results, total, message) == SearchStatus::Busy)
+            {
+                res = make_overload_response(req.version(), cfg.GetRetryAfterSec(), "Server is busy, please retry.");
+            }
+            else
             {
-                std::vector<SearchResult> results = db.SearchDocumentsByWords(words);
                 res = http::response<http::string_body>(http::status::ok, req.version());
                 res.set(http::field::content_type, "text/html; charset=utf-8");
-                res.body() = make_results_page(q, results);
+                res.body() = make_results_page(q, results, message, total);
                 res.prepare_payload();
             }
         }
@@ -162,6 +585,21 @@ void handle_session(tcp::socket socket, Database& db)
             res.prepare_payload();
         }
     }
+    catch (const pqxx::sql_error& e)
+    {
+        // 57014 - query_canceled:  statement_timeout
+        if (e.sqlstate() == "57014")
+        {
+            res = make_overload_response(req.version(), cfg.GetRetryAfterSec(), "Search timed out, please retry.");
+        }
+        else
+        {
+            res = http::response<http::string_body>(http::status::internal_server_error, req.version());
+            res.set(http::field::content_type, "text/html; charset=utf-8");
+            res.body() = std::string("<h1>Internal error</h1><p>") + e.what() + "</p>";
+            res.prepare_payload();
+        }
+    }
     catch (const std::exception& e) 
     {
         res = http::response<http::string_body>(http::status::internal_server_error, req.version());
@@ -170,29 +608,97 @@ void handle_session(tcp::socket socket, Database& db)
         res.prepare_payload();
     }
 
-    http::write(socket, res, ec);
-    socket.shutdown(tcp::socket::shutdown_send, ec);
+    run_with_timeout(ioc, stream, cfg.GetReadTimeoutMs(), [&](auto handler) {
+        http::async_write(stream, res, std::move(handler));
+        });
+    stream.socket().shutdown(tcp::socket::shutdown_send, ec);
 }
 
 // ------------------   -------------------
+static int serve(ServerContext& ctx)
+{
+    const Config& cfg = ctx.cfg;
+    net::io_context ioc{ 1 };
+    tcp::acceptor acceptor{ ioc, {tcp::v4(), static_cast<unsigned short>(cfg.GetServerPort())} };
+    std::cout << "[Server] Listening on port " << cfg.GetServerPort() << "...\n";
+
+    std::atomic<int> sessions{ 0 };
+
+    for (;;) 
+    {
+        //     io_context -     /
+        auto sessionIoc = std::make_shared<net::io_context>(1);
+        tcp::socket socket(*sessionIoc);
+        acceptor.accept(socket);
+
+        if (sessions.load() >= cfg.GetMaxConnections())
+        {
+            //     ,     
+            beast::error_code ec;
+            auto res = make_overload_response(11, cfg.GetRetryAfterSec(), "Too many connections, please retry.");
+            http::write(socket, res, ec);
+            socket.shutdown(tcp::socket::shutdown_both, ec);
+            continue;
+        }
+
+        ++sessions;
+        std::thread([sessionIoc, s = std::move(socket), &ctx, &sessions]() mutable {
+            try { handle_session(*sessionIoc, std::move(s), ctx); }
+            catch (const std::exception& e) { std::cerr << "Session error: " << e.what() << std::endl; }
+            --sessions;
+            }).detach();
+    }
+}
+
 int run_server(const Config& cfg, Database& db) 
 {
     try 
     {
-        net::io_context ioc{ 1 };
-        tcp::acceptor acceptor{ ioc, {tcp::v4(), static_cast<unsigned short>(cfg.GetServerPort())} };
-        std::cout << "[Server] Listening on port " << cfg.GetServerPort() << "...\n";
+        QueryGate gate(db,
+            static_cast<std::size_t>(std::max(1, cfg.GetMaxActiveQueries())),
+            static_cast<std::size_t>(std::max(0, cfg.GetMaxQueuedQueries())));
+        SuggestService suggest(db.connectionString(), cfg.GetSuggestRefreshSec());
 
-        for (;;) 
+        TextAnalyzer analyzer(cfg);
+        try
+        {
+            std::string indexed = db.GetIndexInfo("analyzer");
+            if (indexed != analyzer.signature())
+            {
+                std::cerr << "[Server] Index was built with '" << indexed << "', queries use '"
+                    << analyzer.signature() << "': run the spider to rebuild the index" << std::endl;
+            }
+        }
+        catch (const std::exception& e)
         {
-            tcp::socket socket = acceptor.accept();
-            std::thread(&handle_session, std::move(socket), std::ref(db)).detach();
+            std::cerr << "[Server] Cannot read index info: " << e.what() << std::endl;
         }
+
+        ServerContext ctx{ cfg, analyzer, &gate, &suggest, nullptr };
+        return serve(ctx);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Server error: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+//     : /search  -
+int run_coordinator(const Config& cfg)
+{
+    try 
+    {
+        ShardCoordinator shards(cfg.GetShardServers(), cfg.GetShardTimeoutMs());
+        std::cout << "[Server] Coordinator for " << shards.size() << " shards\n";
+
+        TextAnalyzer analyzer(cfg);
+        ServerContext ctx{ cfg, analyzer, nullptr, nullptr, &shards };
+        return serve(ctx);
     }
     catch (const std::exception& e)
     {
         std::cerr << "Server error: " << e.what() << std::endl;
         return 1;
     }
-    return 0;
 }
@@ -0,0 +1,195 @@
+#include "ShardCoordinator.h"
+#include "Hash.h"
+
+#include <boost/asio.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+#include <boost/beast/version.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+
+namespace beast = boost::beast;
+namespace http = beast::http;
+namespace net = boost::asio;
+using tcp = net::ip::tcp;
+
+namespace {
+
+const std::uint64_t kMaxShardResponse = 1024 * 1024;
+
+std::string url_encode(const std::string& s)
+{
+    static const char hex[] = "0123456789ABCDEF";
+    std::string out;
+    for (unsigned char c : s) {
+        if (std::isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~') {
+            out.push_back(static_cast<char>(c));
+        }
+        else {
+            out.push_back('%');
+            out.push_back(hex[c >> 4]);
+            out.push_back(hex[c & 0xF]);
+        }
+    }
+    return out;
+}
+
+std::string sanitize(const std::string& s)
+{
+    std::string out = s;
+    for (char& c : out) {
+        if (c == '\t' || c == '\n' || c == '\r') c = ' ';
+    }
+    return out;
+}
+
+struct ShardCall
+{
+    explicit ShardCall(net::io_context& ioc) : stream(ioc) {}
+
+    beast::tcp_stream stream;
+    beast::flat_buffer buffer;
+    http::request<http::empty_body> req;
+    http::response_parser<http::string_body> parser;
+    bool ok = false;
+};
+
+} // namespace
+
+std::size_t shardForUrl(const std::string& url, std::size_t shardCount)
+{
+    if (shardCount <= 1) return 0;
+    return static_cast<std::size_t>(fnv1a64(url) % shardCount);
+}
+
+std::string formatShardResults(const std::vector<SearchResult>& results, long long total, bool partial)
+{
+    std::ostringstream oss;
+    oss << "total\t" << total << '\n';
+    if (partial) oss << "partial\t1\n";
+    for (auto& r : results) {
+        oss << r.rank << '\t' << sanitize(r.url) << '\t' << sanitize(r.title) << '\t' << sanitize(r.snippet) << '\n';
+    }
+    return oss.str();
+}
+
+std::vector<SearchResult> parseShardResults(const std::string& body, long long& total, bool* partial)
+{
+    std::vector<SearchResult> results;
+    total = 0;
+    if (partial) *partial = false;
+    std::istringstream iss(body);
+    std::string line;
+    while (std::getline(iss, line)) {
+        auto t1 = line.find('\t');
+        if (t1 == std::string::npos) continue;
+        if (line.compare(0, t1, "total") == 0) {
+            try { total = std::stoll(line.substr(t1 + 1)); }
+            catch (const std::exception&) {}
+            continue;
+        }
+        if (line.compare(0, t1, "partial") == 0) {
+            if (partial) *partial = line.substr(t1 + 1) == "1";
+            continue;
+        }
+        auto t2 = line.find('\t', t1 + 1);
+        if (t2 == std::string::npos) continue;
+        auto t3 = line.find('\t', t2 + 1);
+
+        SearchResult r;
+        try { r.rank = std::stoi(line.substr(0, t1)); }
+        catch (const std::exception&) { continue; }
+        r.url = line.substr(t1 + 1, t2 - t1 - 1);
+        if (t3 == std::string::npos) {
+            r.title = line.substr(t2 + 1);
+        }
+        else {
+            r.title = line.substr(t2 + 1, t3 - t2 - 1);
+            r.snippet = line.substr(t3 + 1);
+        }
+        results.push_back(std::move(r));
+    }
+    return results;
+}
+
+ShardCoordinator::ShardCoordinator(const std::vector<std::string>& shards, int timeoutMs)
+    : m_timeoutMs(timeoutMs)
+{
+    //   ,       
+    net::io_context ioc;
+    tcp::resolver resolver(ioc);
+    for (auto& s : shards) {
+        auto colon = s.rfind(':');
+        if (colon == std::string::npos) throw std::runtime_error("Shard address must be host:port: " + s);
+
+        Shard shard;
+        shard.host = s;
+        shard.endpoints = resolver.resolve(s.substr(0, colon), s.substr(colon + 1));
+        m_shards.push_back(std::move(shard));
+    }
+}
+
+std::vector<SearchResult> ShardCoordinator::search(const std::string& query, std::size_t limit, std::size_t& failedShards, long long& total,
+    std::size_t& partialShards) const
+{
+    net::io_context ioc;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(m_timeoutMs);
+    std::string target = "/shard/search?q=" + url_encode(query);
+
+    std::vector<std::unique_ptr<ShardCall>> calls;
+    for (auto& shard : m_shards) {
+        calls.push_back(std::make_unique<ShardCall>(ioc));
+        ShardCall& call = *calls.back();
+
+        call.req = http::request<http::empty_body>(http::verb::get, target, 11);
+        call.req.set(http::field::host, shard.host);
+        call.req.set(http::field::user_agent, BOOST_BEAST_VERSION_STRING);
+        call.parser.body_limit(kMaxShardResponse);
+
+        //    ,   
+        call.stream.expires_at(deadline);
+        call.stream.async_connect(shard.endpoints, [&call](beast::error_code ec, const tcp::endpoint&) {
+            if (ec) return;
+            http::async_write(call.stream, call.req, [&call](beast::error_code ec, std::size_t) {
+                if (ec) return;
+                http::async_read(call.stream, call.buffer, call.parser, [&call](beast::error_code ec, std::size_t) {
+                    if (ec) return;
+                    call.ok = call.parser.get().result() == http::status::ok;
+                    beast::error_code ignored;
+                    call.stream.socket().shutdown(tcp::socket::shutdown_both, ignored);
+                    });
+                });
+            });
+    }
+
+    ioc.run();
+
+    std::vector<SearchResult> merged;
+    failedShards = 0;
+    partialShards = 0;
+    total = 0;
+    for (std::size_t i = 0; i < calls.size(); ++i) {
+        if (!calls[i]->ok) {
+            ++failedShards;
+            std::cerr << "[Coordinator] Shard " << m_shards[i].host << " did not answer" << std::endl;
+            continue;
+        }
+        long long shardTotal = 0;
+        bool partial = false;
+        auto part = parseShardResults(calls[i]->parser.get().body(), shardTotal, &partial);
+        total += shardTotal;
+        if (partial) ++partialShards;
+        merged.insert(merged.end(), std::make_move_iterator(part.begin()), std::make_move_iterator(part.end()));
+    }
+
+    std::stable_sort(merged.begin(), merged.end(),
+        [](const SearchResult& a, const SearchResult& b) { return a.rank > b.rank; });
+    if (merged.size() > limit) merged.resize(limit);
+    return merged;
+}
@@ -0,0 +1,46 @@
+#pragma once
+#ifndef SHARD_COORDINATOR_H
+#define SHARD_COORDINATOR_H
+
+#include "DBase.h"
+
+#include <boost/asio/ip/tcp.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+//   :   URL,      
+std::size_t shardForUrl(const std::string& url, std::size_t shardCount);
+
+//    GET /shard/search:  "total\tN" (  
+// ), "partial\t1"       ,
+//   "rank\turl\ttitle\tsnippet"
+std::string formatShardResults(const std::vector<SearchResult>& results, long long total, bool partial = false);
+std::vector<SearchResult> parseShardResults(const std::string& body, long long& total, bool* partial = nullptr);
+
+//    -     top-k.
+// ,     timeoutMs, .
+class ShardCoordinator
+{
+public:
+    // shards: "host:port"
+    ShardCoordinator(const std::vector<std::string>& shards, int timeoutMs);
+
+    // total -    , partialShards -      
+    std::vector<SearchResult> search(const std::string& query, std::size_t limit, std::size_t& failedShards, long long& total,
+        std::size_t& partialShards) const;
+    std::size_t size() const { return m_shards.size(); }
+
+private:
+    struct Shard
+    {
+        std::string host;
+        boost::asio::ip::tcp::resolver::results_type endpoints;
+    };
+
+    std::vector<Shard> m_shards;
+    int m_timeoutMs;
+};
+
+#endif // SHARD_COORDINATOR_H
@@ -0,0 +1,94 @@
+#include "SimHash.h"
+#include "Hash.h"
+
+#include <algorithm>
+
+namespace {
+
+std::uint16_t block(std::uint64_t fingerprint, std::size_t i)
+{
+    return static_cast<std::uint16_t>(fingerprint >> (16 * i));
+}
+
+} // namespace
+
+void SimHashBuilder::add(std::string_view term, int weight)
+{
+    std::uint64_t h = fnv1a64(term);
+    for (std::size_t bit = 0; bit < 64; ++bit) {
+        m_weights[bit] += ((h >> bit) & 1) ? weight : -weight;
+    }
+}
+
+std::uint64_t SimHashBuilder::value() const
+{
+    std::uint64_t v = 0;
+    for (std::size_t bit = 0; bit < 64; ++bit) {
+        if (m_weights[bit] > 0) v |= std::uint64_t(1) << bit;
+    }
+    return v;
+}
+
+void SimHashIndex::insert(std::uint64_t fingerprint, DocRef doc)
+{
+    if (doc.docId >= 0) {
+        auto it = m_fingerprints.find(key(doc));
+        if (it != m_fingerprints.end()) {
+            if (it->second == fingerprint) return;
+            erase(it->second, doc);
+            it->second = fingerprint;
+        }
+        else {
+            m_fingerprints.emplace(key(doc), fingerprint);
+        }
+    }
+
+    for (std::size_t i = 0; i < m_blocks.size(); ++i) {
+        m_blocks[i][block(fingerprint, i)].push_back({ fingerprint, doc });
+    }
+    ++m_size;
+}
+
+void SimHashIndex::complete(std::uint64_t fingerprint, std::size_t shard, int docId)
+{
+    erase(fingerprint, DocRef{ shard, kPending });
+    if (docId >= 0) insert(fingerprint, DocRef{ shard, docId });
+}
+
+bool SimHashIndex::erase(std::uint64_t fingerprint, const DocRef& doc)
+{
+    bool removed = false;
+    for (std::size_t i = 0; i < m_blocks.size(); ++i) {
+        auto it = m_blocks[i].find(block(fingerprint, i));
+        if (it == m_blocks[i].end()) continue;
+        auto& items = it->second;
+        auto item = std::find_if(items.begin(), items.end(), [&](const Item& x) {
+            return x.fingerprint == fingerprint && x.doc.shard == doc.shard && x.doc.docId == doc.docId;
+            });
+        if (item == items.end()) continue;
+        items.erase(item);
+        if (items.empty()) m_blocks[i].erase(it);
+        removed = true;
+    }
+    if (removed) --m_size;
+    return removed;
+}
+
+DocRef SimHashIndex::find(std::uint64_t fingerprint, int maxDistance, DocRef exclude) const
+{
+    DocRef best;
+    int bestDistance = std::min(maxDistance, int(kMaxDistance)) + 1;
+    for (std::size_t i = 0; i < m_blocks.size() && bestDistance > 0; ++i) {
+        auto it = m_blocks[i].find(block(fingerprint, i));
+        if (it == m_blocks[i].end()) continue;
+        for (auto& item : it->second) {
+            if (exclude.docId >= 0 && item.doc.docId == exclude.docId && item.doc.shard == exclude.shard) continue;
+            int d = hammingDistance(fingerprint, item.fingerprint);
+            if (d < bestDistance) {
+                bestDistance = d;
+                best = item.doc;
+            }
+        }
+    }
+    return best;
+}
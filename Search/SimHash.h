@@ -0,0 +1,74 @@
+#pragma once
+#ifndef SIM_HASH_H
+#define SIM_HASH_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// 64- SimHash   :    
+//     
+class SimHashBuilder
+{
+public:
+    void add(std::string_view term, int weight);
+    std::uint64_t value() const;
+
+private:
+    std::array<std::int64_t, 64> m_weights{};
+};
+
+inline int hammingDistance(std::uint64_t a, std::uint64_t b)
+{
+    std::uint64_t x = a ^ b;
+    int n = 0;
+    for (; x; x &= x - 1) ++n;
+    return n;
+}
+
+//     -
+struct DocRef
+{
+    std::size_t shard = 0;
+    int docId = -1;
+};
+
+//        3.
+//    4   16 :  3    
+//    ,    4 .
+//    :  ( )  .
+class SimHashIndex
+{
+public:
+    static const int kMaxDistance = 3;
+    // docId ,      
+    static const int kPending = -2;
+
+    void insert(std::uint64_t fingerprint, DocRef doc);
+    //  kPending,   (fingerprint, shard),  docId; docId < 0 -   
+    void complete(std::uint64_t fingerprint, std::size_t shard, int docId);
+    //     maxDistance,  exclude; docId == -1   
+    DocRef find(std::uint64_t fingerprint, int maxDistance, DocRef exclude = DocRef{}) const;
+    std::size_t size() const { return m_size; }
+
+private:
+    struct Item
+    {
+        std::uint64_t fingerprint;
+        DocRef doc;
+    };
+
+    static std::uint64_t key(const DocRef& doc) { return (std::uint64_t(doc.shard) << 32) | std::uint32_t(doc.docId); }
+    //   (fingerprint, doc); false   
+    bool erase(std::uint64_t fingerprint, const DocRef& doc);
+
+    std::array<std::unordered_map<std::uint16_t, std::vector<Item>>, 4> m_blocks;
+    //      ( kPending)
+    std::unordered_map<std::uint64_t, std::uint64_t> m_fingerprints;
+    std::size_t m_size = 0;
+};
+
+#endif // SIM_HASH_H
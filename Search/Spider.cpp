@@ -1,18 +1,47 @@
 #include "Spider.h"
+#include "ContentDecoder.h"
+#include "ShardCoordinator.h"
+#include "TextNormalizer.h"
 
 #include <boost/beast/version.hpp>
 #include <iostream>
 #include <sstream>
 #include <algorithm>
 #include <cctype>
+#include <cstdint>
+#include <thread>
 
 using tcp = boost::asio::ip::tcp;
 namespace beast = boost::beast;
 namespace http = beast::http;
 namespace ssl = boost::asio::ssl;
 
+static const char* const kAnalyzerInfo = "analyzer";
+static const int kReindexBatch = 500;
+static const auto kFingerprintRefresh = std::chrono::seconds(5);
+// ,  ,      ,
+//   ;        
+static const std::int64_t kFingerprintSeqOverlap = 1000;
+
+static std::uint64_t fingerprintOf(const std::unordered_map<std::string, WordStats>& freq)
+{
+    SimHashBuilder simhash;
+    for (auto& p : freq) simhash.add(p.first, p.second.frequency);
+    return simhash.value();
+}
+
 Spider::Spider(Config& config, Database& db, std::size_t threads)
-    : m_config(config), m_db(db), m_pool(threads), m_threads(threads) {
+    : Spider(config, std::vector<Database*>{ &db }, threads) {
+}
+
+Spider::Spider(Config& config, const std::vector<Database*>& shards, std::size_t threads)
+    : m_config(config),
+    m_analyzer(config),
+    m_dns(config.GetDnsTtlSec(), config.GetDnsNegativeTtlSec(), static_cast<std::size_t>(config.GetDnsThreads())),
+    m_pool(threads), m_threads(threads)
+{
+    if (shards.empty()) throw std::invalid_argument("Spider needs at least one database");
+    for (Database* db : shards) m_shards.push_back(std::make_unique<DbShard>(*db));
 }
 
 Spider::~Spider()
@@ -30,11 +59,198 @@ void Spider::run()
         return;
     }
 
-    boost::asio::post(m_pool, [this, start]() {
-        crawl(start, 0);
-        });
+    //   ,    
+    ++m_pending;
+
+    auto peers = m_config.GetSpiderPeers();
+    if (peers.size() > 1)
+    {
+        m_exchange = std::make_unique<CrawlExchange>(peers,
+            static_cast<std::size_t>(m_config.GetSpiderId()),
+            static_cast<std::size_t>(m_config.GetForwardBatchSize()),
+            m_config.GetForwardFlushMs(),
+            m_config.GetTerminationProbeMs(),
+            [this](const std::string& url, int depth) { enqueue(url, depth); },
+            [this]() { return m_pending == 0; });
+    }
+
+    reindexIfNeeded();
+    loadFingerprints();
 
+    //     ,    
+    std::string canonical = normalizeUrl(start, start);
+    schedule(canonical.empty() ? start : canonical, 0);
+    --m_pending;
+
+    //   join-,       
+    if (m_exchange) waitUntilIdle();
     m_pool.join();
+
+    std::uint64_t wire = m_fetchStats.wireBytes, page = m_fetchStats.pageBytes;
+    std::cout << "[Fetch] Body bytes: " << wire << " received, " << page << " after decompression ("
+        << m_fetchStats.compressedPages << " compressed pages";
+    if (wire > 0) std::cout << ", ratio " << static_cast<double>(page) / static_cast<double>(wire);
+    std::cout << ")" << std::endl;
+}
+
+void Spider::schedule(const std::string& url, int depth)
+{
+    if (depth > m_config.GetRecursionDepth()) return;
+
+    if (m_exchange)
+    {
+        std::size_t owner = m_exchange->ownerOf(url);
+        if (owner != m_exchange->self())
+        {
+            m_exchange->forward(owner, url, depth);
+            return;
+        }
+    }
+    enqueue(url, depth);
+}
+
+void Spider::enqueue(const std::string& url, int depth)
+{
+    //   ,       
+    //  DNS     ,     
+    std::string host;
+    unsigned short port = 0;
+    if (splitHostPort(urlHost(url), 0, host, port)) m_dns.lookup(host);
+
+    ++m_pending;
+    boost::asio::post(m_pool, [this, url, depth]() {
+        try {
+            crawl(url, depth);
+        }
+        catch (const std::exception& e) {
+            std::cerr << "crawl failed for " << url << " : " << e.what() << std::endl;
+        }
+        --m_pending;
+        });
+}
+
+void Spider::waitUntilIdle()
+{
+    //     0     
+    m_exchange->waitForTermination();
+    std::cout << "[Crawl] All spiders finished, stopping" << std::endl;
+    m_exchange->stop();
+}
+
+void Spider::reindexIfNeeded()
+{
+    const std::string& signature = m_analyzer.signature();
+    //     :  ,  
+    const bool rebuilder = !m_exchange || m_exchange->self() == 0;
+
+    for (std::size_t i = 0; i < m_shards.size(); ++i)
+    {
+        DbShard& shard = *m_shards[i];
+        auto indexedSignature = [&shard]() {
+            std::lock_guard<std::mutex> lg(shard.mutex);
+            return shard.db.GetIndexInfo(kAnalyzerInfo);
+        };
+        std::string indexed = indexedSignature();
+        if (indexed == signature) continue;
+
+        if (!rebuilder)
+        {
+            std::cout << "[Index] Waiting for spider 0 to rebuild shard " << i << std::endl;
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(m_config.GetReindexWaitSec());
+            while (indexedSignature() != signature)
+            {
+                if (std::chrono::steady_clock::now() >= deadline)
+                    throw std::runtime_error("Shard " + std::to_string(i) + " was not rebuilt for '" + signature +
+                        "' in " + std::to_string(m_config.GetReindexWaitSec()) + " s: is spider 0 running with the same analyzer settings?");
+                std::this_thread::sleep_for(std::chrono::seconds(1));
+            }
+            continue;
+        }
+
+        std::lock_guard<std::mutex> lg(shard.mutex);
+        std::cout << "[Index] Shard " << i << " was built with '" << (indexed.empty() ? "no analyzer" : indexed)
+            << "', rebuilding for '" << signature << "'" << std::endl;
+        shard.db.beginPostingsRebuild();
+
+        int lastId = 0;
+        std::size_t documents = 0;
+        for (;;)
+        {
+            auto batch = shard.db.GetDocumentContents(lastId, kReindexBatch);
+            if (batch.empty()) break;
+
+            pqxx::work txn(shard.db.connection());
+            for (auto& [docId, content] : batch)
+            {
+                std::unordered_map<std::string, WordStats> freq;
+                splitAndCountWords(content, freq);
+                shard.db.updateSimhashTxn(txn, docId, fingerprintOf(freq));
+                for (auto& p : freq) {
+                    int wordId = shard.db.insertWordTxn(txn, p.first, p.second.surface);
+                    shard.db.insertRebuiltDocumentWordTxn(txn, docId, wordId, p.second.frequency, p.second.positions);
+                }
+                lastId = docId;
+            }
+            txn.commit();
+            documents += batch.size();
+        }
+
+        //       ;    
+        shard.db.finishPostingsRebuild(kAnalyzerInfo, signature);
+        std::cout << "[Index] Shard " << i << ": " << documents << " documents reindexed" << std::endl;
+    }
+}
+
+void Spider::loadFingerprints()
+{
+    if (m_config.GetNearDuplicateDistance() < 0) return;
+
+    //   ,   
+    std::unique_lock<std::mutex> refresh(m_fingerprintMutex, std::try_to_lock);
+    if (!refresh.owns_lock()) return;
+    auto now = std::chrono::steady_clock::now();
+    if (now < m_nextFingerprintLoad) return;
+    m_nextFingerprintLoad = now + kFingerprintRefresh;
+
+    const bool initial = m_fingerprintSeq.empty();
+    if (initial) m_fingerprintSeq.assign(m_shards.size(), 0);
+
+    for (std::size_t i = 0; i < m_shards.size(); ++i)
+    {
+        std::vector<std::pair<int, std::uint64_t>> fingerprints;
+        try
+        {
+            std::lock_guard<std::mutex> dbLock(m_shards[i]->mutex);
+            std::int64_t after = initial ? -1 : std::max<std::int64_t>(0, m_fingerprintSeq[i] - kFingerprintSeqOverlap);
+            fingerprints = m_shards[i]->db.GetDocumentFingerprints(after, m_fingerprintSeq[i]);
+        }
+        catch (const std::exception& e)
+        {
+            if (initial) throw;
+            std::cerr << "[Dedup] Fingerprint refresh failed for shard " << i << ": " << e.what() << std::endl;
+            continue;
+        }
+
+        //     
+        std::lock_guard<std::mutex> lg(m_simMutex);
+        for (auto& [docId, fingerprint] : fingerprints)
+            m_simIndex.insert(fingerprint, DocRef{ i, docId });
+    }
+
+    if (initial)
+    {
+        std::lock_guard<std::mutex> lg(m_simMutex);
+        std::cout << "[Dedup] Loaded " << m_simIndex.size() << " fingerprints" << std::endl;
+    }
+}
+
+void Spider::completeReservation(std::uint64_t fingerprint, std::size_t shard, int docId)
+{
+    {
+        std::lock_guard<std::mutex> lg(m_simMutex);
+        m_simIndex.complete(fingerprint, shard, docId);
+    }
+    m_simCv.notify_all();
 }
 
 void Spider::crawl(const std::string& url, int depth)
@@ -46,49 +262,265 @@ void Spider::crawl(const std::string& url, int depth)
         if (!m_visited.insert(url).second) return;
     }
 
-    std::string html;
+    HtmlTokenizer page;
     try {
-        html = fetchPage(url);
+        if (!fetchPage(url, page)) return;
     }
     catch (const std::exception& e) {
         std::cerr << "fetchPage failed for " << url << " : " << e.what() << std::endl;
         return;
     }
+    page.finish();
 
-    std::string title = extractTitle(html);
-    std::string cleaned = cleanText(html);
+    const std::string& title = page.title();
+    const std::string& cleaned = page.text();
 
-    int docId = -1;
+    std::unordered_map<std::string, WordStats> freq;
+    splitAndCountWords(cleaned, freq);
+
+    const std::uint64_t fingerprint = fingerprintOf(freq);
+
+    //      ,   
+    const int maxDistance = freq.size() >= kMinDedupTerms ? m_config.GetNearDuplicateDistance() : -1;
+    const std::size_t shardNo = shardForUrl(url, m_shards.size());
+    DbShard& shard = *m_shards[shardNo];
+
+    DocRef original;
+    if (maxDistance >= 0)
     {
-        std::lock_guard<std::mutex> lg(m_dbMutex);
-        docId = m_db.insertDocument(url, title, cleaned);
-    }
+        loadFingerprints();
 
-    std::unordered_map<std::string, int> freq;
-    splitAndCountWords(cleaned, freq);
+        //         
+        DocRef self{ shardNo, -1 };
+        {
+            std::lock_guard<std::mutex> lg(shard.mutex);
+            self.docId = shard.db.GetDocumentId(url);
+        }
+
+        //      :   ,
+        //  ,   
+        std::unique_lock<std::mutex> lk(m_simMutex);
+        for (;;)
+        {
+            original = m_simIndex.find(fingerprint, maxDistance, self);
+            if (original.docId != SimHashIndex::kPending) break;
+            m_simCv.wait(lk);
+        }
+        if (original.docId < 0) m_simIndex.insert(fingerprint, DocRef{ shardNo, SimHashIndex::kPending });
+    }
 
+    if (original.docId >= 0)
+    {
+        DbShard& canonical = *m_shards[original.shard];
+        std::lock_guard<std::mutex> lg(canonical.mutex);
+        canonical.db.insertAlias(url, original.docId);
+    }
+    else
     {
-        std::lock_guard<std::mutex> lg(m_dbMutex);
-        pqxx::work txn(m_db.connection());
-        for (auto& p : freq) {
-            int wordId = m_db.insertWordTxn(txn, p.first);
-            m_db.insertDocumentWordTxn(txn, docId, wordId, p.second);
+        int docId = -1;
+        try
+        {
+            std::lock_guard<std::mutex> lg(shard.mutex);
+            docId = shard.db.insertDocument(url, title, cleaned, fingerprint);
+        }
+        catch (...)
+        {
+            if (maxDistance >= 0) completeReservation(fingerprint, shardNo, -1);
+            throw;
+        }
+        if (maxDistance >= 0) completeReservation(fingerprint, shardNo, docId);
+
+        {
+            std::lock_guard<std::mutex> lg(shard.mutex);
+            pqxx::work txn(shard.db.connection());
+            shard.db.deleteDocumentWordsTxn(txn, docId);
+            for (auto& p : freq) {
+                int wordId = shard.db.insertWordTxn(txn, p.first, p.second.surface);
+                shard.db.insertDocumentWordTxn(txn, docId, wordId, p.second.frequency, p.second.positions);
+            }
+            txn.commit();
         }
-        txn.commit();
     }
 
-    auto links = extractLinks(html, url);
-    for (auto& lnk : links) {
+    for (auto& raw : page.links()) {
+        std::string lnk = cleanLink(raw);
+        if (lnk.empty()) continue;
         std::string normalized = normalizeUrl(lnk, url);
         if (normalized.empty()) continue;
 
-        boost::asio::post(m_pool, [this, normalized, depth]() {
-            crawl(normalized, depth + 1);
-            });
+        schedule(normalized, depth + 1);
     }
 }
 
-std::string Spider::fetchPage(const std::string& url, int redirectDepth)
+namespace {
+
+enum class FetchResult { Ok, Redirect, Skipped };
+
+// ,     
+bool isTrackingParam(const std::string& name)
+{
+    static const char* const names[] = {
+        "gclid", "fbclid", "yclid", "ymclid", "_openstat", "mc_cid", "mc_eid",
+        "sid", "sessionid", "session_id", "phpsessid", "jsessionid"
+    };
+    if (name.rfind("utm_", 0) == 0) return true;
+    return std::find(std::begin(names), std::end(names), name) != std::end(names);
+}
+
+std::string lowerAscii(std::string s)
+{
+    std::transform(s.begin(), s.end(), s.begin(),
+        [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return s;
+}
+
+// "/a/./b/../c" -> "/a/c"
+std::string removeDotSegments(const std::string& path)
+{
+    std::vector<std::string> segments;
+    std::size_t start = 1;
+    bool trailingSlash = false;
+    while (start <= path.size()) {
+        std::size_t end = path.find('/', start);
+        if (end == std::string::npos) end = path.size();
+        std::string seg = path.substr(start, end - start);
+        trailingSlash = (end < path.size()) || seg == "." || seg == "..";
+        if (seg == "..") {
+            if (!segments.empty()) segments.pop_back();
+        }
+        else if (seg != "." && !(seg.empty() && end < path.size())) {
+            segments.push_back(seg);
+        }
+        start = end + 1;
+    }
+
+    std::string out;
+    for (auto& seg : segments) {
+        out += '/';
+        out += seg;
+    }
+    if (out.empty() || (trailingSlash && out.back() != '/')) out += '/';
+    return out;
+}
+
+//    URL:      , 
+//   ,  ,   ;  
+std::string canonicalUrl(const std::string& url)
+{
+    static const std::regex re(R"(^(https?)://([^/?#]+)([^?#]*)(?:\?([^#]*))?(?:#.*)?$)", std::regex::icase);
+    std::smatch m;
+    if (!std::regex_match(url, m, re)) return {};
+
+    std::string scheme = lowerAscii(m[1].str());
+    std::string host = lowerAscii(m[2].str());
+    auto at = host.rfind('@');
+    if (at != std::string::npos) host.erase(0, at + 1);
+    if ((scheme == "http" && host.size() > 3 && host.compare(host.size() - 3, 3, ":80") == 0) ||
+        (scheme == "https" && host.size() > 4 && host.compare(host.size() - 4, 4, ":443") == 0))
+        host.erase(host.rfind(':'));
+    if (!host.empty() && host.back() == '.') host.pop_back();
+    if (host.empty()) return {};
+
+    std::string path = m[3].str();
+    auto session = lowerAscii(path).find(";jsessionid=");
+    if (session != std::string::npos) path.erase(session);
+    path = removeDotSegments(path.empty() ? "/" : path);
+
+    std::vector<std::string> params;
+    std::istringstream query(m[4].str());
+    std::string param;
+    while (std::getline(query, param, '&')) {
+        if (param.empty()) continue;
+        if (isTrackingParam(lowerAscii(param.substr(0, param.find('='))))) continue;
+        params.push_back(param);
+    }
+    std::sort(params.begin(), params.end());
+
+    std::string out = scheme + "://" + host + path;
+    for (std::size_t i = 0; i < params.size(); ++i) {
+        out += (i == 0 ? '?' : '&');
+        out += params[i];
+    }
+    return out;
+}
+
+bool isHtmlContentType(beast::string_view value)
+{
+    std::string ct(value);
+    std::transform(ct.begin(), ct.end(), ct.begin(),
+        [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return ct.rfind("text/html", 0) == 0 || ct.rfind("application/xhtml+xml", 0) == 0;
+}
+
+//     chunkSize ,     .
+// maxSize     ,   
+template <class Stream>
+FetchResult readResponse(Stream& stream, HtmlTokenizer& tokenizer, std::uint64_t maxSize, std::size_t chunkSize,
+    const std::string& url, std::string& location, FetchStats& stats)
+{
+    beast::flat_buffer buffer;
+    http::response_parser<http::buffer_body> parser;
+    parser.body_limit(maxSize);
+
+    beast::error_code ec;
+    http::read_header(stream, buffer, parser, ec);
+    if (ec == http::error::body_limit) {
+        std::cerr << "Skipping " << url << " : larger than " << maxSize << " bytes" << std::endl;
+        return FetchResult::Skipped;
+    }
+    if (ec) throw beast::system_error(ec);
+
+    auto& res = parser.get();
+    unsigned status = res.result_int();
+    if (status >= 300 && status < 400) {
+        auto it = res.find(http::field::location);
+        if (it != res.end()) {
+            location = std::string(it->value());
+            return FetchResult::Redirect;
+        }
+    }
+    if (status >= 400) return FetchResult::Skipped;
+
+    auto ct = res.find(http::field::content_type);
+    if (ct != res.end() && !isHtmlContentType(ct->value())) return FetchResult::Skipped;
+
+    ContentDecoder::Encoding encoding = ContentDecoder::Encoding::Identity;
+    auto ce = res.find(http::field::content_encoding);
+    if (ce != res.end() && !ContentDecoder::parseEncoding(std::string(ce->value()), encoding)) {
+        std::cerr << "Skipping " << url << " : unsupported Content-Encoding " << ce->value() << std::endl;
+        return FetchResult::Skipped;
+    }
+    ContentDecoder decoder(encoding, tokenizer, maxSize);
+
+    std::vector<char> chunk(chunkSize);
+    while (!parser.is_done()) {
+        res.body().data = chunk.data();
+        res.body().size = chunk.size();
+        http::read(stream, buffer, parser, ec);
+        if (ec == http::error::need_buffer) ec = {};
+
+        if (!decoder.feed(chunk.data(), chunk.size() - res.body().size)) {
+            std::cerr << "Truncating " << url << " : decoded size over " << maxSize << " bytes" << std::endl;
+            break;
+        }
+
+        if (ec == http::error::body_limit) {
+            // chunked-  Content-Length:  ,   
+            std::cerr << "Truncating " << url << " at " << maxSize << " bytes" << std::endl;
+            break;
+        }
+        if (ec) throw beast::system_error(ec);
+    }
+
+    stats.wireBytes += decoder.inputBytes();
+    stats.pageBytes += decoder.outputBytes();
+    if (encoding != ContentDecoder::Encoding::Identity) ++stats.compressedPages;
+    return FetchResult::Ok;
+}
+
+} // namespace
+
+bool Spider::fetchPage(const std::string& url, HtmlTokenizer& tokenizer, int redirectDepth)
 {
     if (redirectDepth > 5) throw std::runtime_error("Too many redirects");
 
@@ -99,49 +531,50 @@ std::string Spider::fetchPage(const std::string& url, int redirectDepth)
     }
 
     std::string scheme = m[1].str();
-    std::string host = m[2].str();
+    std::string authority = m[2].str();
     std::string target = m[3].str();
     if (target.empty()) target = "/";
 
+    // authority      Host,    -  DNS  SNI
+    std::string host;
+    unsigned short port = 0;
+    if (!splitHostPort(urlHost(url), scheme == "http" ? 80 : 443, host, port)) {
+        throw std::runtime_error("Invalid URL: " + url);
+    }
+
+    const std::uint64_t maxSize = static_cast<std::uint64_t>(m_config.GetMaxPageBytes());
+    const std::size_t chunkSize = static_cast<std::size_t>(m_config.GetFetchChunkBytes());
+
+    //   ,     TLS-
+    std::shared_future<DnsCache::Endpoints> addresses = m_dns.lookup(host);
+
     boost::asio::io_context ioc;
+    std::string location;
+    FetchResult result;
+
+    http::request<http::empty_body> req{ http::verb::get, target, 11 };
+    req.set(http::field::host, authority);
+    req.set(http::field::user_agent, BOOST_BEAST_VERSION_STRING);
+    req.set(http::field::accept, "text/html,application/xhtml+xml");
+    req.set(http::field::accept_encoding, ContentDecoder::acceptEncoding());
 
     if (scheme == "http")
     {
-        tcp::resolver resolver(ioc);
         beast::tcp_stream stream(ioc);
 
-        auto const results = resolver.resolve(host, "80");
-        stream.connect(results);
-
-        http::request<http::string_body> req{ http::verb::get, target, 11 };
-        req.set(http::field::host, host);
-        req.set(http::field::user_agent, BOOST_BEAST_VERSION_STRING);
+        stream.connect(DnsCache::withPort(addresses.get(), port));
 
         http::write(stream, req);
-
-        beast::flat_buffer buffer;
-        http::response<http::string_body> res;
-        http::read(stream, buffer, res);
+        result = readResponse(stream, tokenizer, maxSize, chunkSize, url, location, m_fetchStats);
 
         beast::error_code ec;
         stream.socket().shutdown(tcp::socket::shutdown_both, ec);
-
-        if (res.result_int() >= 300 && res.result_int() < 400) {
-            auto it = res.find(http::field::location);
-            if (it != res.end()) {
-                std::string redirectUrl(it->value());
-                return fetchPage(redirectUrl, redirectDepth + 1);
-            }
-        }
-
-        return res.body();
     }
     else
     { // https
         ssl::context ctx{ ssl::context::sslv23_client };
         ctx.set_default_verify_paths();
 
-        tcp::resolver resolver(ioc);
         beast::ssl_stream<beast::tcp_stream> stream(ioc, ctx);
 
         if (!SSL_set_tlsext_host_name(stream.native_handle(), host.c_str()))
@@ -151,134 +584,76 @@ std::string Spider::fetchPage(const std::string& url, int redirectDepth)
                 "Failed to set SNI Hostname");
         }
 
-        auto const results = resolver.resolve(host, "443");
-        beast::get_lowest_layer(stream).connect(results);
+        beast::get_lowest_layer(stream).connect(DnsCache::withPort(addresses.get(), port));
 
         stream.handshake(ssl::stream_base::client);
 
-        http::request<http::string_body> req{ http::verb::get, target, 11 };
-        req.set(http::field::host, host);
-        req.set(http::field::user_agent, BOOST_BEAST_VERSION_STRING);
-
         http::write(stream, req);
-
-        beast::flat_buffer buffer;
-        http::response<http::string_body> res;
-        http::read(stream, buffer, res);
+        result = readResponse(stream, tokenizer, maxSize, chunkSize, url, location, m_fetchStats);
 
         beast::error_code ec;
         beast::get_lowest_layer(stream).socket().shutdown(tcp::socket::shutdown_both, ec);
-
-        if (res.result_int() >= 300 && res.result_int() < 400) {
-            auto it = res.find(http::field::location);
-            if (it != res.end()) {
-                std::string redirectUrl(it->value());
-                return fetchPage(redirectUrl, redirectDepth + 1);
-            }
-        }
-
-        return res.body();
     }
-}
 
-std::string Spider::extractTitle(const std::string& html)
-{
-    static const std::regex titleRe(R"(<title[^>]*>(.*?)</title>)", std::regex::icase);
-    std::smatch m;
-    if (std::regex_search(html, m, titleRe)) {
-        return m[1].str();
+    if (result == FetchResult::Redirect) {
+        std::string redirectUrl = normalizeUrl(location, url);
+        if (redirectUrl.empty()) return false;
+        return fetchPage(redirectUrl, tokenizer, redirectDepth + 1);
     }
-    return {};
+    return result == FetchResult::Ok;
 }
 
-std::string Spider::cleanText(const std::string& html)
+std::string Spider::cleanLink(const std::string& href)
 {
-    std::string s = std::regex_replace(html, std::regex(R"(<script[\s\S]*?</script>)", std::regex::icase), " ");
-    s = std::regex_replace(s, std::regex(R"(<style[\s\S]*?</style>)", std::regex::icase), " ");
-    s = std::regex_replace(s, std::regex(R"(<[^>]*>)"), " ");
-
-    std::string out;
-    out.reserve(s.size());
-    for (unsigned char ch : s) {
-        if (std::isalnum(ch)) out.push_back(static_cast<char>(ch));
-        else out.push_back(' ');
-    }
-
-    std::transform(out.begin(), out.end(), out.begin(),
-        [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
-
-    std::string compact;
-    bool lastSpace = true;
-    for (char c : out) {
-        if (std::isspace(static_cast<unsigned char>(c))) {
-            if (!lastSpace) {
-                compact.push_back(' ');
-                lastSpace = true;
-            }
-        }
-        else {
-            compact.push_back(c);
-            lastSpace = false;
-        }
-    }
-    if (!compact.empty() && compact.back() == ' ') compact.pop_back();
-
-    return compact;
-}
-
-std::vector<std::string> Spider::extractLinks(const std::string& html, const std::string& baseUrl)
-{
-    std::vector<std::string> links;
-    static const std::regex hrefRe(R"(<a\s+[^>]*?href\s*=\s*['"]([^'"]+)['"][^>]*>)", std::regex::icase);
-    auto it = std::sregex_iterator(html.begin(), html.end(), hrefRe);
-    auto end = std::sregex_iterator();
-    for (; it != end; ++it)
-    {
-        std::string raw = (*it)[1].str();
-        if (raw.empty()) continue;
-        if (raw.rfind("javascript:", 0) == 0) continue;
-        if (raw.rfind("mailto:", 0) == 0) continue;
-        size_t pos = raw.find('#');
-        if (pos != std::string::npos) raw.erase(pos);
-        if (raw.empty()) continue;
-        links.push_back(raw);
-    }
-    return links;
+    std::string raw = href;
+    if (raw.empty()) return {};
+    if (raw.rfind("javascript:", 0) == 0) return {};
+    if (raw.rfind("mailto:", 0) == 0) return {};
+    size_t pos = raw.find('#');
+    if (pos != std::string::npos) raw.erase(pos);
+    return raw;
 }
 
 std::string Spider::normalizeUrl(const std::string& link, const std::string& baseUrl)
 {
-    if (link.rfind("http://", 0) == 0 || link.rfind("https://", 0) == 0) return link;
-    if (link.rfind("//", 0) == 0) return "http:" + link;
+    static const std::regex absoluteRe(R"(^https?://)", std::regex::icase);
+    if (std::regex_search(link, absoluteRe)) return canonicalUrl(link);
 
-    static const std::regex baseRe(R"(^https?://([^/]+)(/.*)?$)", std::regex::icase);
+    static const std::regex baseRe(R"(^(https?)://([^/?#]+)([^?#]*))", std::regex::icase);
     std::smatch m;
-    if (!std::regex_match(baseUrl, m, baseRe)) return {};
+    if (!std::regex_search(baseUrl, m, baseRe)) return {};
 
-    std::string host = m[1].str();
-    std::string path = m[2].str();
+    std::string scheme = m[1].str();
+    std::string host = m[2].str();
+    std::string path = m[3].str();
     if (path.empty()) path = "/";
 
-    if (!link.empty() && link[0] == '/')
-    {
-        return "http://" + host + link;
-    }
-    else
-    {
-        auto pos = path.find_last_of('/');
-        std::string basePath = (pos == std::string::npos) ? "/" : path.substr(0, pos + 1);
-        return "http://" + host + basePath + link;
-    }
+    //     ,    http
+    if (link.rfind("//", 0) == 0) return canonicalUrl(scheme + ":" + link);
+    if (link.empty()) return canonicalUrl(baseUrl);
+    if (link[0] == '/') return canonicalUrl(scheme + "://" + host + link);
+    if (link[0] == '?') return canonicalUrl(scheme + "://" + host + path + link);
+
+    auto pos = path.find_last_of('/');
+    std::string basePath = (pos == std::string::npos) ? "/" : path.substr(0, pos + 1);
+    return canonicalUrl(scheme + "://" + host + basePath + link);
 }
 
-void Spider::splitAndCountWords(const std::string& text, std::unordered_map<std::string, int>& outFreq)
+void Spider::splitAndCountWords(const std::string& text, std::unordered_map<std::string, WordStats>& outFreq)
 {
     std::istringstream iss(text);
     std::string token;
-    while (iss >> token)
+    std::uint32_t position = 0;
+    //     ,    -,
+    //     ("  ")  
+    for (; iss >> token; ++position)
     {
-        if (token.size() < 3 || token.size() > 32) continue;
-        outFreq[token]++;
+        std::string term = m_analyzer.term(token);
+        if (term.empty()) continue;
+        WordStats& ws = outFreq[term];
+        if (ws.surface.empty()) ws.surface = token;
+        ws.frequency++;
+        ws.positions.push_back(position);
     }
 }
 
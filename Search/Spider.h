@@ -3,7 +3,12 @@
 #define SPIDER_H
 
 #include "Config.h"
+#include "CrawlExchange.h"
 #include "DBase.h"
+#include "DnsCache.h"
+#include "HtmlTokenizer.h"
+#include "SimHash.h"
+#include "TextAnalyzer.h"
 
 #include <boost/asio.hpp>
 #include <boost/asio/thread_pool.hpp>
@@ -14,6 +19,11 @@
 #include <boost/beast/core.hpp>
 #include <boost/beast/ssl.hpp> 
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 #include <unordered_set>
@@ -21,17 +31,45 @@
 #include <mutex>
 #include <regex>
 
+//           
+struct FetchStats
+{
+    std::atomic<std::uint64_t> wireBytes{ 0 };
+    std::atomic<std::uint64_t> pageBytes{ 0 };
+    std::atomic<std::uint64_t> compressedPages{ 0 };
+};
+
+struct WordStats
+{
+    int frequency = 0;
+    Positions positions;
+    std::string surface; //      
+};
+
 class Spider
 {
 public:
     Spider(Config& config, Database& db, std::size_t threads = 4);
+    //  :       URL
+    Spider(Config& config, const std::vector<Database*>& shards, std::size_t threads = 4);
     ~Spider();
 
     void run();
 
 private:
+    struct DbShard
+    {
+        explicit DbShard(Database& d) : db(d) {}
+        Database& db;
+        std::mutex mutex;
+    };
+
     Config& m_config;
-    Database& m_db;
+    std::vector<std::unique_ptr<DbShard>> m_shards;
+
+    TextAnalyzer m_analyzer;
+    DnsCache m_dns;
+    FetchStats m_fetchStats;
 
     boost::asio::thread_pool m_pool;
     std::size_t m_threads;
@@ -39,20 +77,42 @@ private:
     std::mutex m_visitedMutex;
     std::unordered_set<std::string> m_visited;
 
-    std::mutex m_dbMutex;
+    //      
+    static const std::size_t kMinDedupTerms = 8;
+    std::mutex m_simMutex;
+    //  ,  id ,   m_simIndex
+    std::condition_variable m_simCv;
+    SimHashIndex m_simIndex;
+    // ,       ,
+    //         kFingerprintRefresh
+    std::mutex m_fingerprintMutex;
+    std::vector<std::int64_t> m_fingerprintSeq;
+    std::chrono::steady_clock::time_point m_nextFingerprintLoad{};
+
+    //   (spider_peers):    
+    std::unique_ptr<CrawlExchange> m_exchange;
+    std::atomic<std::size_t> m_pending{ 0 };
 
+    // schedule -    ,  ; enqueue -   
+    void schedule(const std::string& url, int depth);
+    void enqueue(const std::string& url, int depth);
+    void waitUntilIdle();
+    // ,   ,   Documents.content
+    void reindexIfNeeded();
+    //     ,  -  
+    void loadFingerprints();
     void crawl(const std::string& url, int depth);
+    void completeReservation(std::uint64_t fingerprint, std::size_t shard, int docId);
 
-    // HTTP/HTTPS
-    std::string fetchPage(const std::string& url, int redirectDepth = 0);
+    // HTTP/HTTPS:       tokenizer.
+    // false -   ( HTML, ,  )
+    bool fetchPage(const std::string& url, HtmlTokenizer& tokenizer, int redirectDepth = 0);
 
     // /
-    std::string extractTitle(const std::string& html);
-    std::string cleanText(const std::string& html);
-    std::vector<std::string> extractLinks(const std::string& html, const std::string& baseUrl);
+    std::string cleanLink(const std::string& href);
     std::string normalizeUrl(const std::string& link, const std::string& baseUrl);
 
-    void splitAndCountWords(const std::string& text, std::unordered_map<std::string, int>& outFreq);
+    void splitAndCountWords(const std::string& text, std::unordered_map<std::string, WordStats>& outFreq);
     std::string toLower(const std::string& s);
 };
 
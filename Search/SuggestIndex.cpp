@@ -0,0 +1,141 @@
+#include "SuggestIndex.h"
+#include "DBase.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <queue>
+#include <string_view>
+#include <tuple>
+
+SuggestIndex::SuggestIndex(std::vector<std::pair<std::string, int>> words)
+{
+    std::sort(words.begin(), words.end());
+
+    std::size_t total = 0;
+    for (auto& w : words) total += w.first.size();
+    m_blob.reserve(total);
+    m_offsets.reserve(words.size() + 1);
+    m_counts.reserve(words.size());
+
+    for (auto& w : words) {
+        m_offsets.push_back(static_cast<std::uint32_t>(m_blob.size()));
+        m_blob += w.first;
+        m_counts.push_back(static_cast<std::uint32_t>(std::max(0, w.second)));
+    }
+    m_offsets.push_back(static_cast<std::uint32_t>(m_blob.size()));
+
+    //   [n, 2n),    -      
+    const std::size_t n = m_counts.size();
+    m_tree.assign(2 * n, 0);
+    for (std::size_t i = 0; i < n; ++i) m_tree[n + i] = static_cast<std::uint32_t>(i);
+    for (std::size_t i = n; i-- > 1;) {
+        m_tree[i] = better(m_tree[2 * i], m_tree[2 * i + 1]) ? m_tree[2 * i] : m_tree[2 * i + 1];
+    }
+}
+
+std::string SuggestIndex::word(std::size_t i) const
+{
+    return m_blob.substr(m_offsets[i], m_offsets[i + 1] - m_offsets[i]);
+}
+
+bool SuggestIndex::better(std::uint32_t a, std::uint32_t b) const
+{
+    return m_counts[a] != m_counts[b] ? m_counts[a] > m_counts[b] : a < b;
+}
+
+std::uint32_t SuggestIndex::best(std::size_t l, std::size_t r) const
+{
+    const std::size_t n = m_counts.size();
+    std::uint32_t res = static_cast<std::uint32_t>(l);
+    for (l += n, r += n; l < r; l >>= 1, r >>= 1) {
+        if (l & 1) { if (better(m_tree[l], res)) res = m_tree[l]; ++l; }
+        if (r & 1) { --r; if (better(m_tree[r], res)) res = m_tree[r]; }
+    }
+    return res;
+}
+
+std::vector<std::pair<std::string, int>> SuggestIndex::complete(const std::string& prefix, std::size_t limit) const
+{
+    std::vector<std::pair<std::string, int>> out;
+    const std::size_t n = m_counts.size();
+    if (n == 0 || limit == 0) return out;
+
+    std::string_view blob(m_blob);
+    auto at = [&](std::size_t i) { return blob.substr(m_offsets[i], m_offsets[i + 1] - m_offsets[i]); };
+
+    std::size_t lo = 0, hi = n;
+    while (lo < hi) {
+        std::size_t mid = (lo + hi) / 2;
+        if (at(mid) < prefix) lo = mid + 1; else hi = mid;
+    }
+    std::size_t first = lo;
+    hi = n;
+    while (lo < hi) {
+        std::size_t mid = (lo + hi) / 2;
+        if (at(mid).substr(0, prefix.size()) == prefix) lo = mid + 1; else hi = mid;
+    }
+    std::size_t last = lo;
+    if (first == last) return out;
+
+    // ( ,  );    
+    using Range = std::tuple<std::uint32_t, std::size_t, std::size_t>;
+    auto cmp = [this](const Range& a, const Range& b) { return better(std::get<0>(b), std::get<0>(a)); };
+    std::priority_queue<Range, std::vector<Range>, decltype(cmp)> heap(cmp);
+    heap.emplace(best(first, last), first, last);
+
+    while (!heap.empty() && out.size() < limit) {
+        auto [idx, l, r] = heap.top();
+        heap.pop();
+        out.emplace_back(word(idx), static_cast<int>(m_counts[idx]));
+        if (l < idx) heap.emplace(best(l, idx), l, idx);
+        if (idx + 1 < r) heap.emplace(best(idx + 1, r), idx + 1, r);
+    }
+    return out;
+}
+
+SuggestService::SuggestService(const std::string& connectionString, int refreshSec)
+    : m_connStr(connectionString),
+    m_refreshSec(std::max(1, refreshSec)),
+    m_index(std::make_shared<const SuggestIndex>(std::vector<std::pair<std::string, int>>{})),
+    m_stop(false)
+{
+    m_thread = std::thread(&SuggestService::refreshLoop, this);
+}
+
+SuggestService::~SuggestService()
+{
+    {
+        std::lock_guard<std::mutex> lg(m_stopMutex);
+        m_stop = true;
+    }
+    m_stopCv.notify_all();
+    if (m_thread.joinable()) m_thread.join();
+}
+
+std::shared_ptr<const SuggestIndex> SuggestService::snapshot() const
+{
+    return std::atomic_load(&m_index);
+}
+
+void SuggestService::refreshLoop()
+{
+    std::unique_ptr<Database> db;
+    for (;;) {
+        try {
+            if (!db) db = std::make_unique<Database>(m_connStr);
+            auto started = std::chrono::steady_clock::now();
+            auto index = std::make_shared<const SuggestIndex>(db->GetWordDocumentCounts());
+            std::atomic_store(&m_index, std::shared_ptr<const SuggestIndex>(index));
+            auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started).count();
+            std::cout << "[Suggest] Index rebuilt: " << index->size() << " words in " << ms << " ms" << std::endl;
+        }
+        catch (const std::exception& e) {
+            std::cerr << "[Suggest] Refresh failed: " << e.what() << std::endl;
+            db.reset();
+        }
+
+        std::unique_lock<std::mutex> lk(m_stopMutex);
+        if (m_stopCv.wait_for(lk, std::chrono::seconds(m_refreshSec), [this] { return m_stop; })) return;
+    }
+}
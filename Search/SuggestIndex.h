@@ -0,0 +1,63 @@
+#pragma once
+#ifndef SUGGEST_INDEX_H
+#define SUGGEST_INDEX_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+//   :    
+//   ,      ,
+//  top-k   -     k   .
+class SuggestIndex
+{
+public:
+    // words: (,    )
+    explicit SuggestIndex(std::vector<std::pair<std::string, int>> words);
+
+    std::vector<std::pair<std::string, int>> complete(const std::string& prefix, std::size_t limit) const;
+    std::size_t size() const { return m_counts.size(); }
+
+private:
+    std::string word(std::size_t i) const;
+    bool better(std::uint32_t a, std::uint32_t b) const;
+    std::uint32_t best(std::size_t l, std::size_t r) const;
+
+    std::string m_blob;
+    std::vector<std::uint32_t> m_offsets;
+    std::vector<std::uint32_t> m_counts;
+    std::vector<std::uint32_t> m_tree;
+};
+
+//    SuggestIndex     
+//   ;   /suggest  Postgres  .
+class SuggestService
+{
+public:
+    SuggestService(const std::string& connectionString, int refreshSec);
+    ~SuggestService();
+
+    SuggestService(const SuggestService&) = delete;
+    SuggestService& operator=(const SuggestService&) = delete;
+
+    std::shared_ptr<const SuggestIndex> snapshot() const;
+
+private:
+    void refreshLoop();
+
+    std::string m_connStr;
+    int m_refreshSec;
+    std::shared_ptr<const SuggestIndex> m_index;
+
+    std::mutex m_stopMutex;
+    std::condition_variable m_stopCv;
+    bool m_stop;
+    std::thread m_thread;
+};
+
+#endif // SUGGEST_INDEX_H
@@ -0,0 +1,478 @@
+#include "TextAnalyzer.h"
+#include "Config.h"
+#include "Hash.h"
+#include "TextNormalizer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+// ------------------  (Porter2) -------------------
+
+bool isVowelEn(char c)
+{
+    return c == 'a' || c == 'e' || c == 'i' || c == 'o' || c == 'u' || c == 'y';
+}
+
+bool endsWith(const std::string& w, const char* suffix)
+{
+    std::size_t n = std::strlen(suffix);
+    return w.size() >= n && w.compare(w.size() - n, n, suffix) == 0;
+}
+
+//     ,   ,   from
+template <class IsVowel>
+std::size_t regionAfter(const std::string& w, std::size_t from, IsVowel isVowel)
+{
+    for (std::size_t i = from; i + 1 < w.size(); ++i) {
+        if (isVowel(w[i]) && !isVowel(w[i + 1])) return i + 2;
+    }
+    return w.size();
+}
+
+struct Rule
+{
+    const char* suffix;
+    const char* replacement;
+};
+
+//     ; nullptr     
+template <std::size_t N>
+const Rule* longestRule(const std::string& w, const Rule(&rules)[N])
+{
+    const Rule* best = nullptr;
+    for (auto& r : rules) {
+        if (endsWith(w, r.suffix) && (!best || std::strlen(r.suffix) > std::strlen(best->suffix))) best = &r;
+    }
+    return best;
+}
+
+bool endsInShortSyllable(const std::string& w)
+{
+    std::size_t n = w.size();
+    //      Snowball English (2.x),   Porter2  
+    if (endsWith(w, "past")) return true;
+    if (n == 2) return isVowelEn(w[0]) && !isVowelEn(w[1]);
+    if (n < 3) return false;
+    char last = w[n - 1];
+    return !isVowelEn(w[n - 3]) && isVowelEn(w[n - 2]) && !isVowelEn(last)
+        && last != 'w' && last != 'x' && last != 'Y';
+}
+
+void replaceSuffix(std::string& w, std::size_t suffixLen, const char* replacement)
+{
+    w.erase(w.size() - suffixLen);
+    w += replacement;
+}
+
+const Rule kStep2[] = {
+    { "tional", "tion" }, { "enci", "ence" }, { "anci", "ance" }, { "abli", "able" },
+    { "entli", "ent" }, { "izer", "ize" }, { "ization", "ize" }, { "ational", "ate" },
+    { "ation", "ate" }, { "ator", "ate" }, { "alism", "al" }, { "aliti", "al" },
+    { "alli", "al" }, { "fulness", "ful" }, { "ousli", "ous" }, { "ousness", "ous" },
+    { "iveness", "ive" }, { "iviti", "ive" }, { "biliti", "ble" }, { "bli", "ble" },
+    { "ogi", "og" }, { "ogist", "og" }, { "fulli", "ful" }, { "lessli", "less" }, { "li", "" }
+};
+
+const Rule kStep3[] = {
+    { "tional", "tion" }, { "ational", "ate" }, { "alize", "al" }, { "icate", "ic" },
+    { "iciti", "ic" }, { "ical", "ic" }, { "ful", "" }, { "ness", "" }, { "ative", "" }
+};
+
+const Rule kStep4[] = {
+    { "al", "" }, { "ance", "" }, { "ence", "" }, { "er", "" }, { "ic", "" }, { "able", "" },
+    { "ible", "" }, { "ant", "" }, { "ement", "" }, { "ment", "" }, { "ent", "" }, { "ism", "" },
+    { "ate", "" }, { "iti", "" }, { "ous", "" }, { "ive", "" }, { "ize", "" }, { "ion", "" }
+};
+
+// ------------------  (Snowball) -------------------
+//    :  ASCII-    ..,
+//        .
+const char kTranslit[] = "abvgdeZzijklmnoprstufxcCSW%y'EUA";
+
+bool isVowelRu(char c)
+{
+    return std::strchr("aeiouyEUA", c) != nullptr && c != '\0';
+}
+
+// false -      
+bool toTranslit(const std::string& word, std::string& out)
+{
+    out.clear();
+    for (std::size_t i = 0; i < word.size(); i += 2) {
+        unsigned char b0 = static_cast<unsigned char>(word[i]);
+        if (i + 1 >= word.size()) return false;
+        unsigned char b1 = static_cast<unsigned char>(word[i + 1]);
+        unsigned cp = ((b0 & 0x1Fu) << 6) | (b1 & 0x3Fu);
+        if ((b0 & 0xE0) != 0xC0 || (b1 & 0xC0) != 0x80) return false;
+        if (cp == 0x451) out += 'e';
+        else if (cp >= 0x430 && cp <= 0x44F) out += kTranslit[cp - 0x430];
+        else return false;
+    }
+    return !out.empty();
+}
+
+std::string fromTranslit(const std::string& t)
+{
+    std::string out;
+    for (char c : t) {
+        const char* p = std::strchr(kTranslit, c);
+        if (!p || c == '\0') continue;
+        unsigned cp = 0x430 + static_cast<unsigned>(p - kTranslit);
+        out += static_cast<char>(0xC0 | (cp >> 6));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+    return out;
+}
+
+struct Ending
+{
+    const char* suffix;
+    bool afterA; //    :     
+};
+
+//    ,      limit
+template <std::size_t N>
+bool removeEnding(std::string& w, std::size_t limit, const Ending(&endings)[N])
+{
+    const Ending* best = nullptr;
+    std::size_t bestLen = 0;
+    for (auto& e : endings) {
+        std::size_t len = std::strlen(e.suffix);
+        if (len > bestLen && w.size() >= limit + len && endsWith(w, e.suffix)) {
+            best = &e;
+            bestLen = len;
+        }
+    }
+    if (!best) return false;
+
+    std::size_t start = w.size() - bestLen;
+    if (best->afterA && (start == 0 || start - 1 < limit || (w[start - 1] != 'a' && w[start - 1] != 'A'))) return false;
+    w.erase(start);
+    return true;
+}
+
+const Ending kPerfectiveGerund[] = {
+    { "v", true }, { "vSi", true }, { "vSis'", true },
+    { "iv", false }, { "ivSi", false }, { "ivSis'", false },
+    { "yv", false }, { "yvSi", false }, { "yvSis'", false }
+};
+
+const Ending kAdjective[] = {
+    { "ee", false }, { "ie", false }, { "ye", false }, { "oe", false }, { "imi", false }, { "ymi", false },
+    { "ej", false }, { "ij", false }, { "yj", false }, { "oj", false }, { "em", false }, { "im", false },
+    { "ym", false }, { "om", false }, { "ego", false }, { "ogo", false }, { "emu", false }, { "omu", false },
+    { "ix", false }, { "yx", false }, { "uU", false }, { "UU", false }, { "aA", false }, { "AA", false },
+    { "oU", false }, { "eU", false }
+};
+
+const Ending kParticiple[] = {
+    { "em", true }, { "nn", true }, { "vS", true }, { "UW", true }, { "W", true },
+    { "ivS", false }, { "yvS", false }, { "uUW", false }
+};
+
+const Ending kReflexive[] = { { "sA", false }, { "s'", false } };
+
+const Ending kVerb[] = {
+    { "la", true }, { "na", true }, { "ete", true }, { "jte", true }, { "li", true }, { "j", true },
+    { "l", true }, { "em", true }, { "n", true }, { "lo", true }, { "no", true }, { "et", true },
+    { "Ut", true }, { "ny", true }, { "t'", true }, { "eS'", true }, { "nno", true },
+    { "ila", false }, { "yla", false }, { "ena", false }, { "ejte", false }, { "ujte", false },
+    { "ite", false }, { "ili", false }, { "yli", false }, { "ej", false }, { "uj", false },
+    { "il", false }, { "yl", false }, { "im", false }, { "ym", false }, { "en", false },
+    { "ilo", false }, { "ylo", false }, { "eno", false }, { "At", false }, { "uet", false },
+    { "uUt", false }, { "it", false }, { "yt", false }, { "eny", false }, { "it'", false },
+    { "yt'", false }, { "iS'", false }, { "uU", false }, { "U", false }
+};
+
+const Ending kNoun[] = {
+    { "a", false }, { "ev", false }, { "ov", false }, { "ie", false }, { "'e", false }, { "e", false },
+    { "iAmi", false }, { "Ami", false }, { "ami", false }, { "ei", false }, { "ii", false }, { "i", false },
+    { "iej", false }, { "ej", false }, { "oj", false }, { "ij", false }, { "j", false }, { "iAm", false },
+    { "Am", false }, { "iem", false }, { "em", false }, { "am", false }, { "om", false }, { "o", false },
+    { "u", false }, { "ax", false }, { "iAx", false }, { "Ax", false }, { "y", false }, { "'", false },
+    { "iU", false }, { "'U", false }, { "U", false }, { "iA", false }, { "'A", false }, { "A", false }
+};
+
+const Ending kDerivational[] = { { "ost", false }, { "ost'", false } };
+
+std::string stemRussianTranslit(std::string w)
+{
+    auto vowel = [](char c) { return isVowelRu(c); };
+    std::size_t rv = w.size();
+    for (std::size_t i = 0; i < w.size(); ++i) {
+        if (isVowelRu(w[i])) { rv = i + 1; break; }
+    }
+    std::size_t r1 = regionAfter(w, 0, vowel);
+    std::size_t r2 = regionAfter(w, r1, vowel);
+
+    //  1
+    if (!removeEnding(w, rv, kPerfectiveGerund)) {
+        removeEnding(w, rv, kReflexive);
+        if (removeEnding(w, rv, kAdjective)) removeEnding(w, rv, kParticiple);
+        else if (!removeEnding(w, rv, kVerb)) removeEnding(w, rv, kNoun);
+    }
+
+    //  2
+    if (w.size() > rv && w.back() == 'i') w.pop_back();
+
+    //  3
+    removeEnding(w, std::max(rv, r2), kDerivational);
+
+    //  4
+    if (w.size() >= rv + 4 && endsWith(w, "ejSe")) w.erase(w.size() - 4);
+    else if (w.size() >= rv + 3 && endsWith(w, "ejS")) w.erase(w.size() - 3);
+    if (w.size() >= rv + 2 && endsWith(w, "nn")) w.pop_back();
+    else if (w.size() > rv && w.back() == '\'') w.pop_back();
+    return w;
+}
+
+// ------------------ - -------------------
+
+const char* const kEnglishStopWords[] = {
+    "about", "above", "after", "again", "against", "all", "and", "any", "are", "aren't",
+    "because", "been", "before", "being", "below", "between", "both", "but", "can", "cannot",
+    "could", "did", "does", "doing", "down", "during", "each", "few", "for", "from", "further",
+    "had", "has", "have", "having", "her", "here", "hers", "herself", "him", "himself", "his",
+    "how", "into", "its", "itself", "more", "most", "myself", "nor", "not", "off", "once",
+    "only", "other", "ought", "our", "ours", "ourselves", "out", "over", "own", "same", "she",
+    "should", "some", "such", "than", "that", "the", "their", "theirs", "them", "themselves",
+    "then", "there", "these", "they", "this", "those", "through", "too", "under", "until",
+    "very", "was", "were", "what", "when", "where", "which", "while", "who", "whom", "why",
+    "with", "would", "you", "your", "yours", "yourself", "yourselves"
+};
+
+//  ,    
+const char* const kRussianStopWords[] = {
+    "Cto", "kak", "vse", "ona", "tak", "ego", "tol'ko", "mne", "bylo", "vot", "menA", "eWe",
+    "net", "emu", "teper'", "kogda", "daZe", "vdrug", "esli", "uZe", "ili", "byt'", "byl",
+    "nego", "vas", "nibud'", "opAt'", "vam", "ved'", "tam", "potom", "sebA", "niCego", "moZet",
+    "oni", "tut", "gde", "est'", "nado", "nej", "dlA", "tebA", "Cem", "byla", "sam", "Ctob",
+    "bez", "budto", "Cego", "raz", "toZe", "sebe", "pod", "budet", "togda", "kto", "Eto", "Etot",
+    "togo", "potomu", "Etogo", "kakoj", "sovsem", "nim", "zdes'", "Etom", "odin", "poCti",
+    "moj", "tem", "Ctoby", "nee", "sejCas", "byli", "kuda", "zaCem", "vsex", "nikogda",
+    "moZno", "pri", "nakonec", "dva", "drugoj", "xot'", "posle", "nad", "bol'Se", "tot",
+    "Cerez", "Eti", "nas", "pro", "vsego", "nix", "kakaA", "mnogo", "razve", "tri", "Etu",
+    "moA", "vproCem", "xoroSo", "svoU", "Etoj", "pered", "inogda", "luCSe", "Cut'", "tom",
+    "nel'zA", "takoj", "bolee", "vsegda", "koneCno", "vsU", "meZdu"
+};
+
+bool hasLanguage(const std::vector<std::string>& languages, const char* lang)
+{
+    return std::find(languages.begin(), languages.end(), lang) != languages.end();
+}
+
+std::string joinList(const std::vector<std::string>& items)
+{
+    std::string out;
+    for (auto& item : items) {
+        if (!out.empty()) out += ',';
+        out += item;
+    }
+    return out;
+}
+
+} // namespace
+
+std::string stemEnglish(const std::string& word)
+{
+    static const Rule kExceptions[] = {
+        { "skis", "ski" }, { "skies", "sky" }, { "dying", "die" }, { "lying", "lie" }, { "tying", "tie" },
+        { "idly", "idl" }, { "gently", "gentl" }, { "ugly", "ugli" }, { "early", "earli" }, { "only", "onli" },
+        { "singly", "singl" }, { "sky", "sky" }, { "news", "news" }, { "howe", "howe" }, { "atlas", "atlas" },
+        { "cosmos", "cosmos" }, { "bias", "bias" }, { "andes", "andes" }
+    };
+    static const char* const kInvariant[] = {
+        "inning", "outing", "canning", "herring", "earring", "proceed", "exceed", "succeed"
+    };
+
+    for (char c : word) {
+        if ((c < 'a' || c > 'z') && c != '\'') return word;
+    }
+    std::string w = word;
+    if (!w.empty() && w[0] == '\'') w.erase(0, 1);
+    if (w.size() <= 2) return w;
+    for (auto& e : kExceptions) {
+        if (w == e.suffix) return e.replacement;
+    }
+
+    // y        
+    if (w[0] == 'y') w[0] = 'Y';
+    for (std::size_t i = 1; i < w.size(); ++i) {
+        if (w[i] == 'y' && isVowelEn(w[i - 1])) w[i] = 'Y';
+    }
+
+    // R1   ; emerg, inter, later, organ, past, univers -     Snowball
+    static const char* const kR1Prefixes[] = {
+        "arsen", "commun", "emerg", "gener", "inter", "later", "organ", "past", "univers"
+    };
+    std::size_t r1 = std::string::npos;
+    for (auto p : kR1Prefixes) {
+        if (w.compare(0, std::strlen(p), p) == 0) { r1 = std::strlen(p); break; }
+    }
+    if (r1 == std::string::npos) r1 = regionAfter(w, 0, isVowelEn);
+    std::size_t r2 = regionAfter(w, r1, isVowelEn);
+    auto inR1 = [&](std::size_t len) { return w.size() - len >= r1; };
+    auto inR2 = [&](std::size_t len) { return w.size() - len >= r2; };
+    auto restoreY = [](std::string s) { std::replace(s.begin(), s.end(), 'Y', 'y'); return s; };
+
+    //  0
+    if (endsWith(w, "'s'")) w.erase(w.size() - 3);
+    else if (endsWith(w, "'s")) w.erase(w.size() - 2);
+    else if (endsWith(w, "'")) w.pop_back();
+
+    //  1a
+    if (endsWith(w, "sses")) {
+        w.erase(w.size() - 2);
+    }
+    else if (endsWith(w, "ied") || endsWith(w, "ies")) {
+        replaceSuffix(w, 3, w.size() > 4 ? "i" : "ie");
+    }
+    else if (endsWith(w, "us") || endsWith(w, "ss")) {
+    }
+    else if (endsWith(w, "s") && w.size() >= 3) {
+        if (std::any_of(w.begin(), w.end() - 2, isVowelEn)) w.pop_back();
+    }
+
+    for (auto inv : kInvariant) {
+        if (w == inv) return w;
+    }
+
+    //  1b
+    static const char* const kStep1b[] = { "eedly", "ingly", "edly", "eed", "ing", "ed" };
+    const char* found = nullptr;
+    for (auto s : kStep1b) {
+        if (endsWith(w, s)) { found = s; break; }
+    }
+    if (found) {
+        std::size_t len = std::strlen(found);
+        if (std::strcmp(found, "eed") == 0 || std::strcmp(found, "eedly") == 0) {
+            if (inR1(len)) replaceSuffix(w, len, "ee");
+        }
+        else if (std::any_of(w.begin(), w.end() - static_cast<std::ptrdiff_t>(len), isVowelEn)) {
+            w.erase(w.size() - len);
+            static const char* const kDoubles[] = { "bb", "dd", "ff", "gg", "mm", "nn", "pp", "rr", "tt" };
+            if (endsWith(w, "at") || endsWith(w, "bl") || endsWith(w, "iz")) {
+                w += 'e';
+            }
+            else if (std::any_of(std::begin(kDoubles), std::end(kDoubles), [&](const char* d) { return endsWith(w, d); })) {
+                // add, err, off:     
+                if (w.size() != 3 || !std::strchr("aeo", w[0])) w.pop_back();
+            }
+            else if (endsInShortSyllable(w) && r1 >= w.size()) {
+                w += 'e';
+            }
+        }
+    }
+
+    //  1c
+    if (w.size() > 2 && (w.back() == 'y' || w.back() == 'Y') && !isVowelEn(w[w.size() - 2])) w.back() = 'i';
+
+    //  2
+    if (const Rule* r = longestRule(w, kStep2)) {
+        std::size_t len = std::strlen(r->suffix);
+        if (inR1(len)) {
+            if (std::strcmp(r->suffix, "ogi") == 0) {
+                if (w.size() > 3 && w[w.size() - 4] == 'l') replaceSuffix(w, len, r->replacement);
+            }
+            else if (std::strcmp(r->suffix, "li") == 0) {
+                if (w.size() > 2 && std::strchr("cdeghkmnrt", w[w.size() - 3])) replaceSuffix(w, len, r->replacement);
+            }
+            else {
+                replaceSuffix(w, len, r->replacement);
+            }
+        }
+    }
+
+    //  3
+    if (const Rule* r = longestRule(w, kStep3)) {
+        std::size_t len = std::strlen(r->suffix);
+        if (std::strcmp(r->suffix, "ative") == 0 ? inR2(len) : inR1(len)) replaceSuffix(w, len, r->replacement);
+    }
+
+    //  4
+    if (const Rule* r = longestRule(w, kStep4)) {
+        std::size_t len = std::strlen(r->suffix);
+        if (inR2(len)) {
+            if (std::strcmp(r->suffix, "ion") != 0) w.erase(w.size() - len);
+            else if (w.size() > 3 && (w[w.size() - 4] == 's' || w[w.size() - 4] == 't')) w.erase(w.size() - len);
+        }
+    }
+
+    //  5
+    if (endsWith(w, "e")) {
+        if (inR2(1) || (inR1(1) && !endsInShortSyllable(w.substr(0, w.size() - 1)))) w.pop_back();
+    }
+    else if (endsWith(w, "ll") && inR2(1)) {
+        w.pop_back();
+    }
+
+    return restoreY(w);
+}
+
+std::string stemRussian(const std::string& word)
+{
+    std::string t;
+    if (!toTranslit(word, t)) return word;
+    return fromTranslit(stemRussianTranslit(t));
+}
+
+TextAnalyzer::TextAnalyzer(const std::vector<std::string>& stemLanguages,
+    const std::vector<std::string>& stopWordLanguages, const std::string& stopWordsFile)
+    : m_stemEnglish(hasLanguage(stemLanguages, "en")),
+    m_stemRussian(hasLanguage(stemLanguages, "ru"))
+{
+    if (hasLanguage(stopWordLanguages, "en")) {
+        for (auto w : kEnglishStopWords) m_stopWords.insert(w);
+    }
+    if (hasLanguage(stopWordLanguages, "ru")) {
+        for (auto w : kRussianStopWords) m_stopWords.insert(fromTranslit(w));
+    }
+    if (!stopWordsFile.empty()) {
+        std::ifstream in(stopWordsFile);
+        if (!in) throw std::runtime_error("Cannot open stop words file: " + stopWordsFile);
+        std::string line;
+        while (std::getline(in, line)) {
+            std::istringstream iss(normalizeText(line));
+            std::string w;
+            while (iss >> w) m_stopWords.insert(w);
+        }
+    }
+
+    //         -
+    std::vector<std::string> stop(m_stopWords.begin(), m_stopWords.end());
+    std::sort(stop.begin(), stop.end());
+    std::string all;
+    for (auto& w : stop) {
+        all += w;
+        all += '\n';
+    }
+    std::vector<std::string> stem;
+    if (m_stemEnglish) stem.push_back("en");
+    if (m_stemRussian) stem.push_back("ru");
+
+    std::ostringstream sig;
+    sig << "analyzer=2;stem=" << joinList(stem) << ";stop=" << stop.size() << ":" << std::hex << fnv1a64(all);
+    m_signature = sig.str();
+}
+
+TextAnalyzer::TextAnalyzer(const Config& cfg)
+    : TextAnalyzer(cfg.GetStemLanguages(), cfg.GetStopWordLanguages(), cfg.GetStopWordsFile())
+{
+}
+
+std::string TextAnalyzer::term(const std::string& word) const
+{
+    std::size_t len = utf8Length(word);
+    if (len < 3 || len > 32) return {};
+    if (m_stopWords.count(word)) return {};
+
+    if (m_stemEnglish && word[0] >= 'a' && word[0] <= 'z') return stemEnglish(word);
+    if (m_stemRussian && static_cast<unsigned char>(word[0]) >= 0xC0) return stemRussian(word);
+    return word;
+}
@@ -0,0 +1,41 @@
+#pragma once
+#ifndef TEXT_ANALYZER_H
+#define TEXT_ANALYZER_H
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+class Config;
+
+//    (. TextNormalizer)   :
+//    3..32   -,   .
+//      : signature()   
+//   ,      .
+class TextAnalyzer
+{
+public:
+    // : "en", "ru"; stopWordsFile -  -,    
+    TextAnalyzer(const std::vector<std::string>& stemLanguages,
+        const std::vector<std::string>& stopWordLanguages,
+        const std::string& stopWordsFile = {});
+    explicit TextAnalyzer(const Config& cfg);
+
+    //  -      
+    std::string term(const std::string& word) const;
+
+    const std::string& signature() const { return m_signature; }
+
+private:
+    std::unordered_set<std::string> m_stopWords;
+    bool m_stemEnglish = false;
+    bool m_stemRussian = false;
+    std::string m_signature;
+};
+
+// Snowball (Porter2)   a-z;     
+std::string stemEnglish(const std::string& word);
+// Snowball  ; word - UTF-8   ,     
+std::string stemRussian(const std::string& word);
+
+#endif // TEXT_ANALYZER_H
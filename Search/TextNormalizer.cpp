@@ -0,0 +1,556 @@
+#include "TextNormalizer.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define TN_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define TN_TARGET(x)
+#else
+#define TN_TARGET(x) __attribute__((target(x)))
+#endif
+#endif
+
+namespace {
+
+// ------------------ ASCII -------------------
+struct AsciiTable
+{
+    unsigned char map[128];
+
+    AsciiTable()
+    {
+        for (int c = 0; c < 128; ++c) {
+            if ((c >= '0' && c <= '9') || (c >= 'a' && c <= 'z')) map[c] = static_cast<unsigned char>(c);
+            else if (c >= 'A' && c <= 'Z') map[c] = static_cast<unsigned char>(c | 0x20);
+            else map[c] = 0;
+        }
+    }
+};
+
+const AsciiTable kAscii;
+
+//       :  
+//   , ..       UTF-8
+inline char* emitAscii(unsigned char c, char* dst, bool& lastSpace)
+{
+    unsigned char m = kAscii.map[c];
+    if (m) {
+        *dst++ = static_cast<char>(m);
+        lastSpace = false;
+    }
+    else if (!lastSpace) {
+        *dst++ = ' ';
+        lastSpace = true;
+    }
+    return dst;
+}
+
+inline char* emitSpace(char* dst, bool& lastSpace)
+{
+    if (!lastSpace) {
+        *dst++ = ' ';
+        lastSpace = true;
+    }
+    return dst;
+}
+
+// ------------------ Unicode -------------------
+char32_t foldCase(char32_t c)
+{
+    if (c >= 0xC0 && c <= 0xDE && c != 0xD7) return c + 0x20;
+    if (c < 0x100) return c;
+    if (c <= 0x17F) {
+        if ((c <= 0x137) || (c >= 0x14A && c <= 0x177)) return c | 1;
+        if ((c >= 0x139 && c <= 0x148) || (c >= 0x179 && c <= 0x17E)) return (c & 1) ? c + 1 : c;
+        if (c == 0x178) return 0xFF;
+        return c;
+    }
+    if (c < 0x400 || c > 0x4FF) return c;
+    if (c == 0x401 || c == 0x451) return 0x435; //  -> 
+    if (c <= 0x40F) return c + 0x50;
+    if (c <= 0x42F) return c + 0x20;
+    if (c <= 0x45F) return c;
+    if (c <= 0x481 || (c >= 0x48A && c <= 0x4BF) || c >= 0x4D0) return c | 1;
+    if (c == 0x4C0) return 0x4CF;
+    if (c >= 0x4C1 && c <= 0x4CE) return (c & 1) ? c + 1 : c;
+    return c;
+}
+
+bool isWordChar(char32_t c)
+{
+    if (c < 0xC0) return c == 0xAA || c == 0xB5 || c == 0xBA;
+    if (c == 0xD7 || c == 0xF7) return false;
+    if (c == 0x37E || c == 0x387 || c == 0x482) return false;
+    if (c >= 0x2000 && c <= 0x2BFF) return false;   // , , , 
+    if (c >= 0x3000 && c <= 0x303F) return false;   //  CJK
+    if (c >= 0xD800 && c <= 0xDFFF) return false;
+    if (c >= 0xE000 && c <= 0xF8FF) return false;   // private use
+    if (c >= 0xFE10 && c <= 0xFE6F) return false;
+    if (c >= 0xFF00 && c <= 0xFF0F) return false;
+    if (c >= 0xFFF0) return c >= 0x10000 && !(c >= 0x1F000 && c <= 0x1FAFF);
+    return true;
+}
+
+char* appendUtf8(char32_t c, char* dst)
+{
+    if (c < 0x800) {
+        *dst++ = static_cast<char>(0xC0 | (c >> 6));
+        *dst++ = static_cast<char>(0x80 | (c & 0x3F));
+    }
+    else if (c < 0x10000) {
+        *dst++ = static_cast<char>(0xE0 | (c >> 12));
+        *dst++ = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+        *dst++ = static_cast<char>(0x80 | (c & 0x3F));
+    }
+    else {
+        *dst++ = static_cast<char>(0xF0 | (c >> 18));
+        *dst++ = static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+        *dst++ = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+        *dst++ = static_cast<char>(0x80 | (c & 0x3F));
+    }
+    return dst;
+}
+
+std::size_t sequenceLength(unsigned char lead)
+{
+    if (lead >= 0xC2 && lead <= 0xDF) return 2;
+    if (lead >= 0xE0 && lead <= 0xEF) return 3;
+    if (lead >= 0xF0 && lead <= 0xF4) return 4;
+    return 0;
+}
+
+//   , 0    ,
+// 1  cp = 0xFFFD   
+std::size_t decodeUtf8(const unsigned char* p, std::size_t n, char32_t& cp)
+{
+    cp = 0xFFFD;
+    std::size_t len = sequenceLength(p[0]);
+    if (len == 0) return 1;
+
+    unsigned char lo = 0x80, hi = 0xBF;
+    if (p[0] == 0xE0) lo = 0xA0;
+    else if (p[0] == 0xED) hi = 0x9F;
+    else if (p[0] == 0xF0) lo = 0x90;
+    else if (p[0] == 0xF4) hi = 0x8F;
+
+    for (std::size_t i = 1; i < len; ++i) {
+        if (i >= n) return 0;
+        unsigned char b = p[i];
+        if (i == 1 ? (b < lo || b > hi) : (b & 0xC0) != 0x80) return 1;
+    }
+
+    char32_t c = p[0] & (0x7F >> len);
+    for (std::size_t i = 1; i < len; ++i) c = (c << 6) | (p[i] & 0x3F);
+    cp = c;
+    return len;
+}
+
+// ------------------ SIMD -------------------
+inline unsigned countTrailingZeros(std::uint32_t v)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long i;
+    _BitScanForward(&i, v);
+    return static_cast<unsigned>(i);
+#else
+    return static_cast<unsigned>(__builtin_ctz(v));
+#endif
+}
+
+//  ,      ( -> ' '),
+//  ,     
+inline char* emitBlock(const char* buf, unsigned width, std::uint32_t sepMask, char* dst, bool& lastSpace)
+{
+    std::uint32_t drop = sepMask & ((sepMask << 1) | (lastSpace ? 1u : 0u));
+    lastSpace = ((sepMask >> (width - 1)) & 1u) != 0;
+    if (drop == 0) {
+        std::memcpy(dst, buf, width);
+        return dst + width;
+    }
+
+    unsigned start = 0;
+    while (drop) {
+        unsigned i = countTrailingZeros(drop);
+        std::memcpy(dst, buf + start, i - start);
+        dst += i - start;
+        start = i + 1;
+        drop &= drop - 1;
+    }
+    std::memcpy(dst, buf + start, width - start);
+    return dst + (width - start);
+}
+
+//     ASCII   ,    .
+//  -  D0/D1 xx: - (D0 90..9F) -> - (D0 B0..BF),
+// - (D0 A0..AF) -> - (D1 80..8F),  (D0 81)   (D1 91) ->  (D0 B5).
+//     (  )  ,
+// ,   ,    
+using BlockKernel = std::size_t(*)(const unsigned char* p, std::size_t n, char*& dst, bool& lastSpace);
+
+#ifdef TN_X86
+inline std::uint32_t lowBits(unsigned width)
+{
+    return width >= 32 ? 0xFFFFFFFFu : (1u << width) - 1;
+}
+
+TN_TARGET("sse2")
+inline __m128i inRangeSse2(__m128i v, unsigned char lo, unsigned char hi)
+{
+    __m128i clamped = _mm_min_epu8(_mm_max_epu8(v, _mm_set1_epi8(static_cast<char>(lo))), _mm_set1_epi8(static_cast<char>(hi)));
+    return _mm_cmpeq_epi8(clamped, v);
+}
+
+TN_TARGET("sse2")
+std::size_t blockKernelSse2(const unsigned char* p, std::size_t n, char*& dst, bool& lastSpace)
+{
+    const __m128i upperLo = _mm_set1_epi8('A' - 1), upperHi = _mm_set1_epi8('Z' + 1);
+    const __m128i lowerLo = _mm_set1_epi8('a' - 1), lowerHi = _mm_set1_epi8('z' + 1);
+    const __m128i digitLo = _mm_set1_epi8('0' - 1), digitHi = _mm_set1_epi8('9' + 1);
+    const __m128i caseBit = _mm_set1_epi8(0x20);
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i d0 = _mm_set1_epi8(static_cast<char>(0xD0)), d1 = _mm_set1_epi8(static_cast<char>(0xD1));
+    const __m128i yoD0 = _mm_set1_epi8(static_cast<char>(0x81)), yoD1 = _mm_set1_epi8(static_cast<char>(0x91));
+    const __m128i ye = _mm_set1_epi8(static_cast<char>(0xB5));
+
+    alignas(16) char buf[16];
+    std::size_t i = 0;
+    while (i + 16 <= n) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+
+        __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(v, upperLo), _mm_cmplt_epi8(v, upperHi));
+        __m128i lower = _mm_and_si128(_mm_cmpgt_epi8(v, lowerLo), _mm_cmplt_epi8(v, lowerHi));
+        __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(v, digitLo), _mm_cmplt_epi8(v, digitHi));
+        __m128i word = _mm_or_si128(_mm_or_si128(upper, lower), digit);
+        __m128i folded = _mm_or_si128(v, _mm_and_si128(upper, caseBit));
+
+        unsigned width = 16;
+        bool stop = false;
+        std::uint32_t high = static_cast<std::uint32_t>(_mm_movemask_epi8(v));
+        if (high != 0) {
+            __m128i isD0 = _mm_cmpeq_epi8(v, d0), isD1 = _mm_cmpeq_epi8(v, d1);
+            __m128i afterD0 = _mm_slli_si128(isD0, 1), afterD1 = _mm_slli_si128(isD1, 1);
+            __m128i lead = _mm_or_si128(isD0, isD1);
+            std::uint32_t leadMask = static_cast<std::uint32_t>(_mm_movemask_epi8(lead));
+            if (leadMask & 0x8000u) width = 15;
+
+            __m128i yo1 = _mm_and_si128(afterD0, _mm_cmpeq_epi8(v, yoD0));
+            __m128i yo2 = _mm_and_si128(afterD1, _mm_cmpeq_epi8(v, yoD1));
+            __m128i upper1 = _mm_and_si128(afterD0, inRangeSse2(v, 0x90, 0x9F));
+            __m128i upper2 = _mm_and_si128(afterD0, inRangeSse2(v, 0xA0, 0xAF));
+            __m128i tail = _mm_or_si128(_mm_or_si128(_mm_and_si128(afterD0, inRangeSse2(v, 0x90, 0xBF)),
+                _mm_and_si128(afterD1, inRangeSse2(v, 0x80, 0x8F))), _mm_or_si128(yo1, yo2));
+            std::uint32_t tailMask = static_cast<std::uint32_t>(_mm_movemask_epi8(tail));
+
+            // -ASCII  -  D0/D1         ;
+            //        
+            leadMask &= lowBits(width);
+            std::uint32_t bad = ((high & ~(leadMask | tailMask)) | (((leadMask << 1) & ~tailMask) >> 1)) & lowBits(width);
+            if (bad) {
+                width = countTrailingZeros(bad);
+                stop = true;
+            }
+
+            __m128i yo = _mm_or_si128(yo1, yo2);
+            folded = _mm_add_epi8(folded, _mm_and_si128(upper1, caseBit));
+            folded = _mm_sub_epi8(folded, _mm_and_si128(upper2, caseBit));
+            folded = _mm_or_si128(_mm_andnot_si128(yo, folded), _mm_and_si128(yo, ye));
+            //  : D0 -> D1  -, D1 -> D0   ( = -1)
+            folded = _mm_sub_epi8(folded, _mm_srli_si128(upper2, 1));
+            folded = _mm_add_epi8(folded, _mm_srli_si128(yo2, 1));
+            word = _mm_or_si128(word, _mm_or_si128(lead, tail));
+        }
+
+        if (width > 0) {
+            __m128i res = _mm_or_si128(_mm_and_si128(word, folded), _mm_andnot_si128(word, space));
+            std::uint32_t sep = ~static_cast<std::uint32_t>(_mm_movemask_epi8(word)) & lowBits(width);
+            _mm_store_si128(reinterpret_cast<__m128i*>(buf), res);
+            dst = emitBlock(buf, width, sep, dst, lastSpace);
+            i += width;
+        }
+        if (stop) break;
+    }
+    return i;
+}
+
+//      128- : [j] = v[j - 1]  [j] = v[j + 1]
+TN_TARGET("avx2")
+inline __m256i shiftPrevAvx2(__m256i v)
+{
+    return _mm256_alignr_epi8(v, _mm256_permute2x128_si256(v, v, 0x08), 15);
+}
+
+TN_TARGET("avx2")
+inline __m256i shiftNextAvx2(__m256i v)
+{
+    return _mm256_alignr_epi8(_mm256_permute2x128_si256(v, v, 0x81), v, 1);
+}
+
+TN_TARGET("avx2")
+inline __m256i inRangeAvx2(__m256i v, unsigned char lo, unsigned char hi)
+{
+    __m256i clamped = _mm256_min_epu8(_mm256_max_epu8(v, _mm256_set1_epi8(static_cast<char>(lo))), _mm256_set1_epi8(static_cast<char>(hi)));
+    return _mm256_cmpeq_epi8(clamped, v);
+}
+
+TN_TARGET("avx2")
+std::size_t blockKernelAvx2(const unsigned char* p, std::size_t n, char*& dst, bool& lastSpace)
+{
+    const __m256i upperLo = _mm256_set1_epi8('A' - 1), upperHi = _mm256_set1_epi8('Z' + 1);
+    const __m256i lowerLo = _mm256_set1_epi8('a' - 1), lowerHi = _mm256_set1_epi8('z' + 1);
+    const __m256i digitLo = _mm256_set1_epi8('0' - 1), digitHi = _mm256_set1_epi8('9' + 1);
+    const __m256i caseBit = _mm256_set1_epi8(0x20);
+    const __m256i space = _mm256_set1_epi8(' ');
+    const __m256i d0 = _mm256_set1_epi8(static_cast<char>(0xD0)), d1 = _mm256_set1_epi8(static_cast<char>(0xD1));
+    const __m256i yoD0 = _mm256_set1_epi8(static_cast<char>(0x81)), yoD1 = _mm256_set1_epi8(static_cast<char>(0x91));
+    const __m256i ye = _mm256_set1_epi8(static_cast<char>(0xB5));
+
+    alignas(32) char buf[32];
+    std::size_t i = 0;
+    while (i + 32 <= n) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+
+        __m256i upper = _mm256_and_si256(_mm256_cmpgt_epi8(v, upperLo), _mm256_cmpgt_epi8(upperHi, v));
+        __m256i lower = _mm256_and_si256(_mm256_cmpgt_epi8(v, lowerLo), _mm256_cmpgt_epi8(lowerHi, v));
+        __m256i digit = _mm256_and_si256(_mm256_cmpgt_epi8(v, digitLo), _mm256_cmpgt_epi8(digitHi, v));
+        __m256i word = _mm256_or_si256(_mm256_or_si256(upper, lower), digit);
+        __m256i folded = _mm256_or_si256(v, _mm256_and_si256(upper, caseBit));
+
+        unsigned width = 32;
+        bool stop = false;
+        std::uint32_t high = static_cast<std::uint32_t>(_mm256_movemask_epi8(v));
+        if (high != 0) {
+            __m256i isD0 = _mm256_cmpeq_epi8(v, d0), isD1 = _mm256_cmpeq_epi8(v, d1);
+            __m256i afterD0 = shiftPrevAvx2(isD0), afterD1 = shiftPrevAvx2(isD1);
+            __m256i lead = _mm256_or_si256(isD0, isD1);
+            std::uint32_t leadMask = static_cast<std::uint32_t>(_mm256_movemask_epi8(lead));
+            if (leadMask & 0x80000000u) width = 31;
+
+            __m256i yo1 = _mm256_and_si256(afterD0, _mm256_cmpeq_epi8(v, yoD0));
+            __m256i yo2 = _mm256_and_si256(afterD1, _mm256_cmpeq_epi8(v, yoD1));
+            __m256i upper1 = _mm256_and_si256(afterD0, inRangeAvx2(v, 0x90, 0x9F));
+            __m256i upper2 = _mm256_and_si256(afterD0, inRangeAvx2(v, 0xA0, 0xAF));
+            __m256i tail = _mm256_or_si256(_mm256_or_si256(_mm256_and_si256(afterD0, inRangeAvx2(v, 0x90, 0xBF)),
+                _mm256_and_si256(afterD1, inRangeAvx2(v, 0x80, 0x8F))), _mm256_or_si256(yo1, yo2));
+            std::uint32_t tailMask = static_cast<std::uint32_t>(_mm256_movemask_epi8(tail));
+
+            leadMask &= lowBits(width);
+            std::uint32_t bad = ((high & ~(leadMask | tailMask)) | (((leadMask << 1) & ~tailMask) >> 1)) & lowBits(width);
+            if (bad) {
+                width = countTrailingZeros(bad);
+                stop = true;
+            }
+
+            __m256i yo = _mm256_or_si256(yo1, yo2);
+            folded = _mm256_add_epi8(folded, _mm256_and_si256(upper1, caseBit));
+            folded = _mm256_sub_epi8(folded, _mm256_and_si256(upper2, caseBit));
+            folded = _mm256_or_si256(_mm256_andnot_si256(yo, folded), _mm256_and_si256(yo, ye));
+            folded = _mm256_sub_epi8(folded, shiftNextAvx2(upper2));
+            folded = _mm256_add_epi8(folded, shiftNextAvx2(yo2));
+            word = _mm256_or_si256(word, _mm256_or_si256(lead, tail));
+        }
+
+        if (width > 0) {
+            __m256i res = _mm256_or_si256(_mm256_and_si256(word, folded), _mm256_andnot_si256(word, space));
+            std::uint32_t sep = ~static_cast<std::uint32_t>(_mm256_movemask_epi8(word)) & lowBits(width);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(buf), res);
+            dst = emitBlock(buf, width, sep, dst, lastSpace);
+            i += width;
+        }
+        if (stop) break;
+    }
+    return i;
+}
+
+bool cpuHasSse2()
+{
+#if defined(__x86_64__) || defined(_M_X64)
+    return true;
+#elif defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[3] & (1 << 26)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse2");
+#endif
+}
+
+bool cpuHasAvx2()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx) return false;
+    if ((_xgetbv(0) & 6) != 6) return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif // TN_X86
+
+struct Kernel
+{
+    const char* name;
+    BlockKernel fn;
+    std::size_t width;
+};
+
+Kernel detectKernel()
+{
+#ifdef TN_X86
+    if (cpuHasAvx2()) return { "avx2", &blockKernelAvx2, 32 };
+    if (cpuHasSse2()) return { "sse2", &blockKernelSse2, 16 };
+#endif
+    return { "scalar", nullptr, 0 };
+}
+
+const Kernel& kernel()
+{
+    static const Kernel k = detectKernel();
+    return k;
+}
+
+} // namespace
+
+TextNormalizer::TextNormalizer()
+    : m_pendingSize(0), m_lastUsed(0), m_lastSpace(true)
+{
+}
+
+void TextNormalizer::append(const char* data, std::size_t size, std::string& out)
+{
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(data);
+    std::size_t base = out.size();
+    out.resize(base + size + m_pendingSize);
+    char* dst = &out[0] + base;
+
+    //  ,    
+    if (m_pendingSize) {
+        std::size_t need = sequenceLength(m_pending[0]);
+        while (m_pendingSize < need && size > 0 && (*p & 0xC0) == 0x80) {
+            m_pending[m_pendingSize++] = *p++;
+            --size;
+        }
+        if (m_pendingSize < need && size == 0) {
+            out.resize(base);
+            return;
+        }
+
+        if (m_pendingSize == need) {
+            dst = appendCodepoint(m_pending, m_pendingSize, dst);
+        }
+        else {
+            dst = emitSpace(dst, m_lastSpace);
+        }
+        m_pendingSize = 0;
+    }
+
+    dst = appendScalar(p, size, dst);
+    out.resize(static_cast<std::size_t>(dst - out.data()));
+}
+
+char* TextNormalizer::appendScalar(const unsigned char* p, std::size_t n, char* dst)
+{
+    const Kernel& k = kernel();
+    std::size_t i = 0;
+    std::size_t scalarUntil = 0;
+    while (i < n) {
+        unsigned char c = p[i];
+        if (k.fn && i >= scalarUntil && n - i >= k.width && (c < 0x80 || c == 0xD0 || c == 0xD1)) {
+            std::size_t done = k.fn(p + i, n - i, dst, m_lastSpace);
+            i += done;
+            // SIMD    :   ,   SIMD;
+            //      ,    
+            scalarUntil = done ? i + 1 : i + k.width;
+            continue;
+        }
+        if (c < 0x80) {
+            dst = emitAscii(c, dst, m_lastSpace);
+            ++i;
+            continue;
+        }
+
+        //  U+0400..U+047F -   ,   
+        if ((c == 0xD0 || c == 0xD1) && i + 1 < n && (p[i + 1] & 0xC0) == 0x80) {
+            char32_t cp = foldCase((static_cast<char32_t>(c & 0x1F) << 6) | (p[i + 1] & 0x3F));
+            *dst++ = static_cast<char>(0xC0 | (cp >> 6));
+            *dst++ = static_cast<char>(0x80 | (cp & 0x3F));
+            m_lastSpace = false;
+            i += 2;
+            continue;
+        }
+
+        char* next = appendCodepoint(p + i, n - i, dst);
+        if (next == nullptr) {
+            std::memcpy(m_pending, p + i, n - i);
+            m_pendingSize = n - i;
+            return dst;
+        }
+        dst = next;
+        i += m_lastUsed;
+    }
+    return dst;
+}
+
+char* TextNormalizer::appendCodepoint(const unsigned char* p, std::size_t n, char* dst)
+{
+    char32_t cp;
+    m_lastUsed = decodeUtf8(p, n, cp);
+    if (m_lastUsed == 0) return nullptr;
+
+    if (isWordChar(cp)) {
+        m_lastSpace = false;
+        return appendUtf8(foldCase(cp), dst);
+    }
+    return emitSpace(dst, m_lastSpace);
+}
+
+void TextNormalizer::boundary(std::string& out)
+{
+    m_pendingSize = 0;
+    if (!m_lastSpace) {
+        out.push_back(' ');
+        m_lastSpace = true;
+    }
+}
+
+void TextNormalizer::finish(std::string& out)
+{
+    boundary(out);
+    if (!out.empty() && out.back() == ' ') out.pop_back();
+    m_lastSpace = true;
+}
+
+std::string normalizeText(const std::string& text)
+{
+    std::string out;
+    TextNormalizer normalizer;
+    normalizer.append(text, out);
+    normalizer.finish(out);
+    return out;
+}
+
+std::size_t utf8Length(const std::string& s)
+{
+    std::size_t n = 0;
+    for (unsigned char c : s) {
+        if ((c & 0xC0) != 0x80) ++n;
+    }
+    return n;
+}
+
+const char* textNormalizerKernel()
+{
+    return kernel().name;
+}
@@ -0,0 +1,47 @@
+#pragma once
+#ifndef TEXT_NORMALIZER_H
+#define TEXT_NORMALIZER_H
+
+#include <cstddef>
+#include <string>
+
+//  UTF-8     :
+//   (, ), ,   /, -> ,
+//    . ASCII    (-, ) 
+// SSE2/AVX2 ,     ;  
+// ( ..  ,   ) -  , .
+class TextNormalizer
+{
+public:
+    TextNormalizer();
+
+    //        out.
+    //     UTF-8 .
+    void append(const char* data, std::size_t size, std::string& out);
+    void append(const std::string& text, std::string& out) { append(text.data(), text.size(), out); }
+
+    //   (,   HTML-)
+    void boundary(std::string& out);
+
+    //  :      
+    void finish(std::string& out);
+
+private:
+    char* appendScalar(const unsigned char* p, std::size_t n, char* dst);
+    char* appendCodepoint(const unsigned char* p, std::size_t n, char* dst);
+
+    unsigned char m_pending[4];
+    std::size_t m_pendingSize;
+    std::size_t m_lastUsed;
+    bool m_lastSpace;
+};
+
+std::string normalizeText(const std::string& text);
+
+//    ( ),    
+std::size_t utf8Length(const std::string& s);
+
+//    ("avx2", "sse2", "scalar")
+const char* textNormalizerKernel();
+
+#endif // TEXT_NORMALIZER_H
@@ -6,6 +6,7 @@
 
 //    SearchServer.cpp
 int run_server(const Config& cfg, Database& db);
+int run_coordinator(const Config& cfg);
 
 int main(int argc, char* argv[])
 {
@@ -15,6 +16,7 @@ int main(int argc, char* argv[])
     try 
     {
         Config cfg(cfgFile);
+        if (cfg.GetServerMode() == "coordinator") return run_coordinator(cfg);
 
         std::ostringstream conn;
         conn << "host=" << cfg.GetDbHost()
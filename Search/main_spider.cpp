@@ -3,7 +3,9 @@
 #include "Spider.h"
 
 #include <iostream>
+#include <memory>
 #include <sstream>
+#include <vector>
 
 int main(int argc, char* argv[]) 
 {
@@ -14,15 +16,26 @@ int main(int argc, char* argv[])
     {
         Config cfg(cfgFile);
 
-        std::ostringstream conn;
-        conn << "host=" << cfg.GetDbHost()
-            << " port=" << cfg.GetDbPort()
-            << " dbname=" << cfg.GetDbName()
-            << " user=" << cfg.GetDbUser()
-            << " password=" << cfg.GetDbPass();
+        //   -  ,       URL
+        std::vector<std::string> dbNames = cfg.GetDbShards();
+        if (dbNames.empty()) dbNames.push_back(cfg.GetDbName());
 
-        Database db(conn.str());
-        Spider spider(cfg, db, 8); // 8 
+        std::vector<std::unique_ptr<Database>> dbs;
+        std::vector<Database*> shards;
+        for (auto& name : dbNames)
+        {
+            std::ostringstream conn;
+            conn << "host=" << cfg.GetDbHost()
+                << " port=" << cfg.GetDbPort()
+                << " dbname=" << name
+                << " user=" << cfg.GetDbUser()
+                << " password=" << cfg.GetDbPass();
+
+            dbs.push_back(std::make_unique<Database>(conn.str()));
+            shards.push_back(dbs.back().get());
+        }
+
+        Spider spider(cfg, shards, 8); // 8 
         spider.run();
     }
     catch (const std::exception& e) 
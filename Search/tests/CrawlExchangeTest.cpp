@@ -0,0 +1,66 @@
+#include "CrawlExchange.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+//  :    1   seq  1,
+//          
+static const std::vector<std::string> kPeers = { "127.0.0.1:39151", "127.0.0.1:39152" };
+
+struct Received
+{
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::set<std::string> urls;
+
+    bool waitFor(const std::string& url)
+    {
+        std::unique_lock<std::mutex> lk(mutex);
+        return cv.wait_for(lk, std::chrono::seconds(10), [&] { return urls.count(url) > 0; });
+    }
+};
+
+static std::unique_ptr<CrawlExchange> makeSender()
+{
+    return std::make_unique<CrawlExchange>(kPeers, 1, 1, 20, 100,
+        [](const std::string&, int) {}, [] { return true; });
+}
+
+int main()
+{
+    Received received;
+    CrawlExchange owner(kPeers, 0, 1, 20, 100,
+        [&received](const std::string& url, int) {
+            std::lock_guard<std::mutex> lg(received.mutex);
+            received.urls.insert(url);
+            received.cv.notify_all();
+        },
+        [] { return true; });
+
+    int failures = 0;
+    auto sender = makeSender();
+    sender->forward(0, "http://first.example/", 1);
+    if (!received.waitFor("http://first.example/")) {
+        std::cerr << "FAILED: first batch was not delivered" << std::endl;
+        ++failures;
+    }
+    sender.reset();
+
+    //     :      seq 1
+    sender = makeSender();
+    sender->forward(0, "http://second.example/", 1);
+    if (!received.waitFor("http://second.example/")) {
+        std::cerr << "FAILED: batch after the sender restart was dropped" << std::endl;
+        ++failures;
+    }
+    sender.reset();
+
+    std::cout << (failures ? "crawl exchange: failed" : "crawl exchange: ok") << std::endl;
+    return failures ? 1 : 0;
+}
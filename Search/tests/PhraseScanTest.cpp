@@ -0,0 +1,63 @@
+#include "PhraseScan.h"
+
+#include <iostream>
+#include <string>
+
+//   :  , ,  statement_timeout,
+//  deadline,    
+static int failures = 0;
+
+static void expect(bool ok, const std::string& what)
+{
+    if (!ok) {
+        ++failures;
+        std::cerr << "FAILED: " << what << std::endl;
+    }
+}
+
+//  1..count;       id,  -  id;
+//   timeoutBatch ( )  
+static CandidateFetch fakeFetch(int count, int timeoutBatch, int& calls)
+{
+    return [count, timeoutBatch, &calls](int afterId, int limit, int, std::vector<SearchCandidate>& batch) {
+        if (calls++ == timeoutBatch) return false;
+        for (int id = afterId + 1; id <= count && static_cast<int>(batch.size()) < limit; ++id) {
+            SearchCandidate c;
+            c.id = id;
+            batch.push_back(c);
+        }
+        return true;
+    };
+}
+
+static bool evenIds(const SearchCandidate& c, int& rank)
+{
+    rank = c.id;
+    return c.id % 2 == 0;
+}
+
+int main()
+{
+    auto later = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+
+    int calls = 0;
+    PhraseScanResult all = scanPhrases(fakeFetch(25, -1, calls), evenIds, 10, 3, later);
+    expect(all.complete, "full scan is complete");
+    expect(all.matches == 12, "full scan counts every match");
+    expect(all.top.size() == 3 && all.top[0].id == 24 && all.top[2].id == 20, "full scan keeps the best matches");
+    expect(calls == 3, "full scan stops after a short batch");
+
+    //   :    
+    calls = 0;
+    PhraseScanResult partial = scanPhrases(fakeFetch(25, 1, calls), evenIds, 10, 3, later);
+    expect(!partial.complete, "timed out scan is incomplete");
+    expect(partial.matches == 5, "timed out scan counts matches of finished batches");
+    expect(partial.top.size() == 3 && partial.top[0].id == 10, "timed out scan returns the best found so far");
+
+    calls = 0;
+    PhraseScanResult late = scanPhrases(fakeFetch(25, -1, calls), evenIds, 10, 3, std::chrono::steady_clock::now());
+    expect(!late.complete && late.matches == 0 && calls == 0, "expired deadline fetches nothing");
+
+    std::cout << (failures ? "phrase scan: failed" : "phrase scan: ok") << std::endl;
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,45 @@
+#include "TextAnalyzer.h"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+//    :  stems_en.txt  stems_ru.txt  " "
+// (UTF-8),     Snowball    
+//  (      inter-,   Snowball )
+static int checkFile(const std::string& path, std::string (*stem)(const std::string&))
+{
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "Cannot open " << path << std::endl;
+        return 1;
+    }
+
+    int checked = 0;
+    int failed = 0;
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream iss(line);
+        std::string word, expected;
+        if (!(iss >> word >> expected)) continue;
+        ++checked;
+        std::string actual = stem(word);
+        if (actual != expected) {
+            ++failed;
+            std::cerr << path << ": " << word << " -> " << actual << ", expected " << expected << std::endl;
+        }
+    }
+    std::cout << path << ": " << checked - failed << "/" << checked << " ok" << std::endl;
+    return checked == 0 || failed > 0 ? 1 : 0;
+}
+
+int main(int argc, char* argv[])
+{
+    std::string dir = argc > 1 ? argv[1] : ".";
+
+    int failed = checkFile(dir + "/stems_en.txt", stemEnglish);
+    failed += checkFile(dir + "/stems_ru.txt", stemRussian);
+
+    return failed ? 1 : 0;
+}